@@ -2,13 +2,638 @@
 #include <vector>
 #include <queue>
 #include <cstdlib>
+#include <climits>
 #include <algorithm>
 #include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <cmath>
+#include <unordered_set>
+#include <unordered_map>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
 
 // я устав...
 using namespace std;
 using namespace chrono;
 
+// Параллельный цикл по [0, count): потоки по очереди забирают порции по chunkSize элементов
+// и вызывают body(номер потока, начало, конец)
+template <typename Func>
+void parallelChunks(size_t count, int numThreads, size_t chunkSize, Func body) {
+    atomic<size_t> nextChunk(0);
+    auto worker = [&](int id) {
+        while (true) {
+            size_t begin = nextChunk.fetch_add(chunkSize, memory_order_relaxed);
+            if (begin >= count) break;
+            body(id, begin, min(begin + chunkSize, count));
+        }
+    };
+
+    vector<thread> threads;
+    for (int id = 1; id < numThreads; ++id) {
+        threads.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+// Генераторы случайных графов за O(E): рёбра выдаются сразу списком, без перебора случайных пар
+// по матрице смежности. Работа делится на фиксированное число блоков, у каждого блока свой поток
+// случайных чисел, выведенный из seed, поэтому результат не зависит от числа потоков.
+// Петли, повторы и превышение maxDegree (если maxDegree > 0) отсекаются одним проходом в порядке блоков.
+class GraphGenerator {
+private:
+    int numVertices;
+    bool directed;
+    int maxDegree;
+    unsigned long long seed;
+    int numThreads;
+
+    static const int maxBlocks = 256;
+
+    mt19937_64 blockRng(int block) const {
+        return mt19937_64(mix(seed ^ mix(block + 1)));
+    }
+
+    // Наибольшее возможное число рёбер с учётом ограничения степени
+    long long maxEdgeCount() const {
+        long long n = numVertices;
+        long long pairs = directed ? n * (n - 1) : n * (n - 1) / 2;
+        if (maxDegree > 0) {
+            pairs = min(pairs, directed ? n * maxDegree : n * maxDegree / 2);
+        }
+        return pairs;
+    }
+
+    // Запуск generateBlock(b, out) для всех блоков на numThreads потоках
+    template <typename Func>
+    vector<vector<pair<int, int>>> runBlocks(int blocks, Func generateBlock) const {
+        vector<vector<pair<int, int>>> parts(blocks);
+        atomic<int> nextBlock(0);
+        auto worker = [&]() {
+            for (int b = nextBlock++; b < blocks; b = nextBlock++) {
+                generateBlock(b, parts[b]);
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < numThreads; ++t) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : threads) {
+            t.join();
+        }
+        return parts;
+    }
+
+    // Добавление ребра в результат, если это не петля, не повтор и степени концов не превышены
+    bool acceptEdge(int u, int v, vector<int>& degree, unordered_set<unsigned long long>* seen,
+                    vector<pair<int, int>>& edgeList) const {
+        if (u == v) return false;
+        if (!directed && u > v) swap(u, v);
+        if (maxDegree > 0 && (degree[u] >= maxDegree || (!directed && degree[v] >= maxDegree))) return false;
+        if (seen && !seen->insert(((unsigned long long)u << 32) | (unsigned)v).second) return false;
+
+        ++degree[u];
+        if (!directed) ++degree[v];
+        edgeList.push_back({u, v});
+        return true;
+    }
+
+    // Общая часть G(n, m) и R-MAT: блоки независимо выдают кандидатов через sample(rng),
+    // затем кандидаты отбираются по порядку, а недостающие рёбра добираются отдельным потоком
+    template <typename Sampler>
+    vector<pair<int, int>> sampleEdges(long long m, Sampler sample) const {
+        m = min(m, maxEdgeCount());
+        vector<pair<int, int>> edgeList;
+        if (m <= 0) return edgeList;
+
+        auto parts = runBlocks(maxBlocks, [&](int b, vector<pair<int, int>>& out) {
+            long long count = m * (b + 1) / maxBlocks - m * b / maxBlocks;
+            mt19937_64 rng = blockRng(b);
+            out.reserve(count);
+            for (long long i = 0; i < count; ++i) {
+                out.push_back(sample(rng));
+            }
+        });
+
+        vector<int> degree(numVertices, 0);
+        unordered_set<unsigned long long> seen;
+        seen.reserve(m);
+        edgeList.reserve(m);
+
+        for (auto& part : parts) {
+            for (auto& edge : part) {
+                if ((long long)edgeList.size() == m) break;
+                acceptEdge(edge.first, edge.second, degree, &seen, edgeList);
+            }
+            vector<pair<int, int>>().swap(part);
+        }
+
+        // Добор тем же генератором, пока он ещё часто даёт новые рёбра: окно из topUpWindow попыток
+        // должно принести хотя бы одно ребро на восемь, иначе генератор упирается в повторы
+        // и насыщенные вершины (у R-MAT с ограничением степени концентраторы заполняются первыми)
+        mt19937_64 rng = blockRng(maxBlocks);
+        const long long topUpWindow = 1 << 16;
+        while ((long long)edgeList.size() < m) {
+            size_t before = edgeList.size();
+            for (long long i = 0; i < topUpWindow && (long long)edgeList.size() < m; ++i) {
+                auto edge = sample(rng);
+                acceptEdge(edge.first, edge.second, degree, &seen, edgeList);
+            }
+            if ((long long)(edgeList.size() - before) < topUpWindow / 8) break;
+        }
+
+        // Остаток — равномерно среди вершин, у которых ещё есть свободная степень
+        if ((long long)edgeList.size() < m) topUpUniform(m, degree, seen, edgeList, rng);
+
+        if ((long long)edgeList.size() < m) {
+            cerr << "GraphGenerator: generated " << edgeList.size() << " of " << m << " requested edges\n";
+        }
+        return edgeList;
+    }
+
+    // Добор рёбер между случайными ненасыщенными вершинами (в ориентированном графе насыщается
+    // только начало ребра). Останавливается, когда и здесь окно попыток почти ничего не даёт
+    void topUpUniform(long long m, vector<int>& degree, unordered_set<unsigned long long>& seen,
+                      vector<pair<int, int>>& edgeList, mt19937_64& rng) const {
+        vector<int> open, position(numVertices, -1);
+        for (int v = 0; v < numVertices; ++v) {
+            if (maxDegree <= 0 || degree[v] < maxDegree) {
+                position[v] = open.size();
+                open.push_back(v);
+            }
+        }
+        auto close = [&](int v) {
+            if (maxDegree <= 0 || degree[v] < maxDegree || position[v] == -1) return;
+            int last = open.back();
+            open[position[v]] = last;
+            position[last] = position[v];
+            open.pop_back();
+            position[v] = -1;
+        };
+
+        const long long topUpWindow = 1 << 16;
+        uniform_int_distribution<int> anyVertex(0, numVertices - 1);
+        while ((long long)edgeList.size() < m && open.size() >= (directed ? 1u : 2u)) {
+            size_t before = edgeList.size();
+            for (long long i = 0; i < topUpWindow && (long long)edgeList.size() < m && !open.empty(); ++i) {
+                int u = open[rng() % open.size()];
+                int v = directed ? anyVertex(rng) : open[rng() % open.size()];
+                if (acceptEdge(u, v, degree, &seen, edgeList)) {
+                    close(u);
+                    if (!directed) close(v);
+                }
+            }
+            if ((long long)(edgeList.size() - before) < topUpWindow / 1000) break;
+        }
+    }
+
+public:
+    // Перемешивание битов splitmix64: из seed и номера блока получается независимое зерно
+    static unsigned long long mix(unsigned long long x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    GraphGenerator(int vertices, bool isDirected, int maxEdgesPerVertex, unsigned long long seedValue, int threads = 1)
+        : numVertices(vertices), directed(isDirected), maxDegree(maxEdgesPerVertex),
+          seed(seedValue), numThreads(max(1, threads)) {}
+
+    // Эрдёш–Реньи G(n, p): каждая пара соединяется с вероятностью p. Пары перебираются по строкам,
+    // и между соседними рёбрами сразу пропускается геометрически распределённое число пар
+    // (Batagelj, Brandes), так что работа пропорциональна числу рёбер, а не n^2
+    vector<pair<int, int>> erdosRenyiGnp(double p) const {
+        vector<pair<int, int>> edgeList;
+        if (p <= 0 || numVertices < 2) return edgeList;
+
+        int blocks = min(numVertices, (int)maxBlocks);
+        auto rowLength = [&](long long v) { return directed ? (long long)numVertices - 1 : v; };
+
+        auto parts = runBlocks(blocks, [&](int b, vector<pair<int, int>>& out) {
+            long long rowBegin = (long long)numVertices * b / blocks;
+            long long rowEnd = (long long)numVertices * (b + 1) / blocks;
+            mt19937_64 rng = blockRng(b);
+            uniform_real_distribution<double> uniform(0.0, 1.0);
+            double logQ = log(1.0 - p);
+
+            long long v = rowBegin, w = -1;
+            while (v < rowEnd) {
+                double skip = p >= 1.0 ? 0.0 : floor(log(1.0 - uniform(rng)) / logQ);
+                w += 1 + (long long)min(skip, 1e15);
+                while (v < rowEnd && w >= rowLength(v)) {
+                    w -= rowLength(v);
+                    ++v;
+                }
+                if (v < rowEnd) {
+                    // В ориентированном графе номер столбца пропускает диагональ
+                    out.push_back({(int)v, (int)(directed && w >= v ? w + 1 : w)});
+                }
+            }
+        });
+
+        vector<int> degree(numVertices, 0);
+        for (auto& part : parts) {
+            for (auto& edge : part) {
+                acceptEdge(edge.first, edge.second, degree, nullptr, edgeList);
+            }
+            vector<pair<int, int>>().swap(part);
+        }
+        return edgeList;
+    }
+
+    // Эрдёш–Реньи G(n, m): ровно m различных рёбер (или сколько позволяет ограничение степени),
+    // повторы отсекаются хеш-множеством
+    vector<pair<int, int>> erdosRenyiGnm(long long m) const {
+        int n = numVertices;
+        return sampleEdges(m, [n](mt19937_64& rng) {
+            uniform_int_distribution<int> pick(0, n - 1);
+            int u = pick(rng);
+            int v = pick(rng);
+            return make_pair(u, v);
+        });
+    }
+
+    // R-MAT (Chakrabarti et al.): каждое ребро спускается по квадрантам матрицы смежности
+    // с вероятностями a, b, c, 1 - a - b - c, что даёт степенное распределение степеней.
+    // Номера вершин затем перемешиваются, чтобы вершины-концентраторы не стояли подряд в начале
+    vector<pair<int, int>> rmat(long long m, double a = 0.57, double b = 0.19, double c = 0.19) const {
+        int n = numVertices;
+        int scale = 0;
+        while ((1LL << scale) < n) ++scale;
+
+        vector<pair<int, int>> edgeList = sampleEdges(m, [=](mt19937_64& rng) {
+            uniform_real_distribution<double> uniform(0.0, 1.0);
+            while (true) {
+                long long u = 0, v = 0;
+                for (int level = 0; level < scale; ++level) {
+                    double r = uniform(rng);
+                    int row = r >= a + b;
+                    int col = (r >= a && r < a + b) || r >= a + b + c;
+                    u = u * 2 + row;
+                    v = v * 2 + col;
+                }
+                if (u < n && v < n) return make_pair((int)u, (int)v);
+            }
+        });
+
+        vector<int> permutation(n);
+        for (int v = 0; v < n; ++v) permutation[v] = v;
+        mt19937_64 rng = blockRng(maxBlocks + 1);
+        shuffle(permutation.begin(), permutation.end(), rng);
+        for (auto& edge : edgeList) {
+            edge = {permutation[edge.first], permutation[edge.second]};
+        }
+        return edgeList;
+    }
+};
+
+// Двоичный формат графа, версия 1 (все числа little-endian, как в памяти x86):
+//   GraphFileHeader
+//   uint64 offsets[numVertices + 1] — начало списка соседей каждой вершины (CSR)
+//   int32  targets[numArcs]         — соседи; неориентированное ребро хранится в обе стороны
+//   int32  weights[numArcs]         — веса рёбер, только если в flags есть graphFileWeighted
+// Тот же формат читает lab 5.
+struct GraphFileHeader {
+    char magic[4];          // "GRPH"
+    uint32_t version;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t numVertices;
+    uint64_t numArcs;
+};
+
+const uint32_t graphFileVersion = 1;
+const uint32_t graphFileDirected = 1;
+const uint32_t graphFileWeighted = 2;
+
+// Граф из двоичного файла, отображённого в память через mmap: массивы CSR используются
+// прямо из отображения, без разбора и копирования
+class MappedGraph {
+private:
+    void* data = MAP_FAILED;
+    size_t size = 0;
+    const GraphFileHeader* header = nullptr;
+    const uint64_t* offsets = nullptr;
+    const int32_t* targets = nullptr;
+    const int32_t* weights = nullptr;
+
+public:
+    explicit MappedGraph(const string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("Cannot open graph file " + path);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GraphFileHeader)) {
+            close(fd);
+            throw runtime_error("Graph file is too short: " + path);
+        }
+        size = st.st_size;
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) throw runtime_error("Cannot mmap graph file " + path);
+
+        header = static_cast<const GraphFileHeader*>(data);
+        uint64_t n = header->numVertices, arcs = header->numArcs;
+        // Поля заголовка ограничиваются размером файла до вычисления ожидаемого размера:
+        // иначе подобранные numVertices или numArcs переполнят сумму и она совпадёт с настоящей
+        if (n > (size - sizeof(GraphFileHeader)) / sizeof(uint64_t) || arcs > size / sizeof(int32_t)) {
+            munmap(data, size);
+            throw runtime_error("Not a version 1 graph file: " + path);
+        }
+        uint64_t expected = sizeof(GraphFileHeader) + (n + 1) * sizeof(uint64_t) + arcs * sizeof(int32_t);
+        if (header->flags & graphFileWeighted) expected += arcs * sizeof(int32_t);
+
+        if (memcmp(header->magic, "GRPH", 4) != 0 || header->version != graphFileVersion
+            || n > INT_MAX || size != expected) {
+            munmap(data, size);
+            throw runtime_error("Not a version 1 graph file: " + path);
+        }
+
+        offsets = reinterpret_cast<const uint64_t*>(header + 1);
+        targets = reinterpret_cast<const int32_t*>(offsets + n + 1);
+        if (header->flags & graphFileWeighted) weights = targets + arcs;
+
+        // Один проход по offsets и targets: смещения не убывают, а концы дуг — номера вершин,
+        // иначе neighborsBegin/neighborsEnd и обход соседей выйдут за пределы отображения
+        bool valid = offsets[0] == 0 && offsets[n] == arcs;
+        for (uint64_t v = 0; valid && v < n; ++v) {
+            valid = offsets[v] <= offsets[v + 1];
+        }
+        for (uint64_t i = 0; valid && i < arcs; ++i) {
+            valid = targets[i] >= 0 && (uint64_t)targets[i] < n;
+        }
+        if (!valid) {
+            munmap(data, size);
+            throw runtime_error("Corrupted offsets or targets in graph file " + path);
+        }
+    }
+
+    ~MappedGraph() {
+        if (data != MAP_FAILED) munmap(data, size);
+    }
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    int getNumVertices() const { return header->numVertices; }
+    long long getNumArcs() const { return header->numArcs; }
+    bool isDirected() const { return header->flags & graphFileDirected; }
+    bool isWeighted() const { return weights != nullptr; }
+
+    // Соседи вершины v: [neighborsBegin(v), neighborsEnd(v)), веса лежат по тем же индексам
+    const int32_t* neighborsBegin(int v) const { return targets + offsets[v]; }
+    const int32_t* neighborsEnd(int v) const { return targets + offsets[v + 1]; }
+    const int32_t* weightsBegin(int v) const { return weights ? weights + offsets[v] : nullptr; }
+};
+
+// Создание файла нужного размера и отображение его в память для записи
+char* mapOutputFile(const string& path, size_t size) {
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw runtime_error("Cannot create graph file " + path);
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        throw runtime_error("Cannot resize graph file " + path);
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) throw runtime_error("Cannot mmap graph file " + path);
+    return static_cast<char*>(data);
+}
+
+// Разбор строки текстового списка рёбер "u v [w]"; пустые строки и комментарии (#, %) пропускаются
+bool parseEdgeLine(const string& line, long long& u, long long& v, long long& w, bool& hasWeight) {
+    const char* p = line.c_str();
+    while (*p == ' ' || *p == '\t') ++p;
+    if (*p == '\0' || *p == '#' || *p == '%' || *p == '\r') return false;
+
+    char* endPtr;
+    u = strtoll(p, &endPtr, 10);
+    if (endPtr == p) return false;
+    p = endPtr;
+    v = strtoll(p, &endPtr, 10);
+    if (endPtr == p) return false;
+    p = endPtr;
+    w = strtoll(p, &endPtr, 10);
+    hasWeight = endPtr != p;
+    return true;
+}
+
+// Потоковый импорт текстового списка рёбер в двоичный формат. Файл читается дважды: сначала
+// считаются степени, затем соседи пишутся сразу на свои места в отображённый выходной файл,
+// так что в памяти держатся только массивы размера O(V). Веса берутся из третьего столбца,
+// если он есть в первой строке с ребром; петли в неориентированном графе отбрасываются
+void importEdgeList(const string& textPath, const string& binaryPath, bool directed) {
+    ifstream input(textPath);
+    if (!input) throw runtime_error("Cannot open edge list " + textPath);
+
+    vector<uint64_t> degree;
+    string line;
+    long long u, v, w;
+    bool hasWeight, weighted = false, firstEdge = true;
+
+    while (getline(input, line)) {
+        if (!parseEdgeLine(line, u, v, w, hasWeight)) continue;
+        if (u < 0 || v < 0 || u >= INT_MAX || v >= INT_MAX) throw runtime_error("Bad vertex id in line: " + line);
+        if (firstEdge) {
+            weighted = hasWeight;
+            firstEdge = false;
+        }
+        if ((long long)degree.size() <= max(u, v)) degree.resize(max(u, v) + 1, 0);
+        if (!directed && u == v) continue;
+
+        ++degree[u];
+        if (!directed) ++degree[v];
+    }
+
+    uint64_t n = degree.size();
+    vector<uint64_t> cursor(n + 1, 0);
+    for (uint64_t i = 0; i < n; ++i) {
+        cursor[i + 1] = cursor[i] + degree[i];
+    }
+    uint64_t arcs = cursor[n];
+    vector<uint64_t>().swap(degree);
+
+    size_t size = sizeof(GraphFileHeader) + (n + 1) * sizeof(uint64_t) + arcs * sizeof(int32_t) * (weighted ? 2 : 1);
+    char* data = mapOutputFile(binaryPath, size);
+
+    GraphFileHeader* header = reinterpret_cast<GraphFileHeader*>(data);
+    memcpy(header->magic, "GRPH", 4);
+    header->version = graphFileVersion;
+    header->flags = (directed ? graphFileDirected : 0) | (weighted ? graphFileWeighted : 0);
+    header->reserved = 0;
+    header->numVertices = n;
+    header->numArcs = arcs;
+
+    uint64_t* offsets = reinterpret_cast<uint64_t*>(header + 1);
+    int32_t* targets = reinterpret_cast<int32_t*>(offsets + n + 1);
+    int32_t* weights = weighted ? targets + arcs : nullptr;
+    memcpy(offsets, cursor.data(), (n + 1) * sizeof(uint64_t));
+
+    input.clear();
+    input.seekg(0);
+    while (getline(input, line)) {
+        if (!parseEdgeLine(line, u, v, w, hasWeight)) continue;
+        if (!directed && u == v) continue;
+        if (weighted && !hasWeight) w = 1;
+
+        uint64_t slot = cursor[u]++;
+        targets[slot] = v;
+        if (weighted) weights[slot] = w;
+        if (!directed) {
+            slot = cursor[v]++;
+            targets[slot] = u;
+            if (weighted) weights[slot] = w;
+        }
+    }
+
+    munmap(data, size);
+}
+
+// Очереди с приоритетом для dijkstra<Queue>. Общий интерфейс: Queue(n), push(v, d) — добавить
+// вершину или уменьшить её ключ, pop() — пара (v, d) с минимальным d, empty(). Очередь может
+// вернуть устаревшую пару (d больше текущего расстояния) — dijkstra такие пропускает
+
+// Двоичная куча std::priority_queue без уменьшения ключа: каждое улучшение добавляет новую пару
+class LazyBinaryHeap {
+private:
+    priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>> heap;
+
+public:
+    explicit LazyBinaryHeap(int) {}
+
+    void push(int v, long long d) { heap.push({d, v}); }
+
+    pair<int, long long> pop() {
+        auto top = heap.top();
+        heap.pop();
+        return {top.second, top.first};
+    }
+
+    bool empty() const { return heap.empty(); }
+};
+
+// Индексированная D-арная куча с уменьшением ключа: position[v] — место вершины в куче
+template <int D>
+class IndexedDaryHeap {
+private:
+    vector<int> heap;
+    vector<long long> key;
+    vector<int> position;
+
+    void siftUp(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (key[heap[parent]] <= key[v]) break;
+            heap[i] = heap[parent];
+            position[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = v;
+        position[v] = i;
+    }
+
+    void siftDown(int i) {
+        int v = heap[i];
+        int size = heap.size();
+        while (true) {
+            int first = D * i + 1;
+            if (first >= size) break;
+            int best = first;
+            for (int c = first + 1; c < min(first + D, size); ++c) {
+                if (key[heap[c]] < key[heap[best]]) best = c;
+            }
+            if (key[heap[best]] >= key[v]) break;
+            heap[i] = heap[best];
+            position[heap[i]] = i;
+            i = best;
+        }
+        heap[i] = v;
+        position[v] = i;
+    }
+
+public:
+    explicit IndexedDaryHeap(int n) : key(n), position(n, -1) {}
+
+    void push(int v, long long d) {
+        key[v] = d;
+        if (position[v] == -1) {
+            heap.push_back(v);
+            siftUp(heap.size() - 1);
+        } else {
+            siftUp(position[v]);
+        }
+    }
+
+    pair<int, long long> pop() {
+        int v = heap[0];
+        position[v] = -1;
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) siftDown(0);
+        return {v, key[v]};
+    }
+
+    bool empty() const { return heap.empty(); }
+};
+
+// Очередь Дейкстры–Дайла: циклический массив корзин по значению расстояния.
+// Годится для небольших целых весов: одновременно заняты не больше maxWeight + 1 корзин
+class BucketQueue {
+private:
+    vector<vector<pair<int, long long>>> buckets;
+    long long current = 0;
+    long long count = 0;
+
+public:
+    explicit BucketQueue(int, int maxWeight = 100) : buckets(maxWeight + 1) {}
+
+    // Наибольший вес ребра, при котором корзины не перекрываются
+    int maxWeight() const { return (int)buckets.size() - 1; }
+
+    void push(int v, long long d) {
+        buckets[d % buckets.size()].push_back({v, d});
+        ++count;
+    }
+
+    pair<int, long long> pop() {
+        while (buckets[current % buckets.size()].empty()) ++current;
+        auto& bucket = buckets[current % buckets.size()];
+        auto top = bucket.back();
+        bucket.pop_back();
+        --count;
+        return top;
+    }
+
+    bool empty() const { return count == 0; }
+};
+
+// Способы перенумерации вершин для RandomGraph::reorder
+enum class VertexOrder {
+    Degree,               // по убыванию степени: вершины-концентраторы лежат рядом в начале
+    ReverseCuthillMcKee,  // обратный порядок Катхилла–Макки: соседи получают близкие номера
+    Bfs                   // порядок обхода в ширину
+};
+
 class RandomGraph {
 private:
     int numVertices; // Количество вершин
@@ -16,7 +641,96 @@ private:
     bool directed;   // Направленность графа
     vector<vector<int>> adjMatrix;    // Матрица смежности
     vector<vector<int>> adjList;      // Список смежности
+    vector<vector<int>> reverseAdjList; // Обратный список смежности (входящие рёбра), только для ориентированного графа
     vector<pair<int, int>> edges;     // Список рёбер
+    vector<vector<int>> weightList;   // Веса рёбер по тем же индексам, что и adjList (пусто — граф невзвешенный)
+    vector<int> originalIds;          // Исходный номер каждой вершины после reorder() (пусто — не перенумерован)
+    vector<int> internalIds;          // Обратное отображение: исходный номер -> текущий
+
+    bool verbose = true;  // Печатать ли найденные пути
+    int lastPathLength = -1;   // Длина (в рёбрах) последнего найденного пути
+    int lastVisitedCount = 0;  // Сколько вершин посетил последний bfs/bfsBidirectional
+    long long lastRelaxations = 0;  // Сколько релаксаций рёбер сделал последний dijkstra/deltaStepping
+
+    // Динамический режим (addEdge/removeEdge): для каждой дуги u -> v хранится её место в adjList[u],
+    // в reverseAdjList[v] и в edges, так что удаление — это обмен с последним элементом за O(1).
+    // Там же поддерживаются компоненты связности (для ориентированного графа — слабой связности)
+    struct ArcSlots {
+        int adj;
+        int rev;
+        int edge;
+    };
+    bool dynamicMode = false;
+    unordered_map<uint64_t, ArcSlots> arcIndex;
+    vector<int> componentOf;               // Номер компоненты вершины
+    vector<vector<int>> componentMembers;  // Вершины каждой компоненты
+    vector<int> memberPos;                 // Место вершины в componentMembers
+    vector<int> freeComponentIds;
+    int numComponents = 0;
+    vector<int> searchMark;                // Отметки встречного поиска при удалении ребра
+    int searchStamp = 0;
+
+    static uint64_t arcKey(int u, int v) {
+        return (uint64_t)u << 32 | (uint32_t)v;
+    }
+
+    // Матрица смежности строится только для графов не больше этого размера
+    static const int maxMatrixVertices = 5000;
+
+    // Пороги переключения направления для BFS с оптимизацией направления (Beamer et al.):
+    // top-down -> bottom-up, когда рёбер у фронта больше, чем (непосещённых рёбер) / alpha;
+    // bottom-up -> top-down, когда фронт меньше, чем numVertices / beta
+    int doAlpha = 14;
+    int doBeta = 24;
+
+    void allocate() {
+        if (numVertices <= maxMatrixVertices) {
+            adjMatrix.resize(numVertices, vector<int>(numVertices, 0));
+        }
+        adjList.resize(numVertices);
+        if (directed) reverseAdjList.resize(numVertices);
+    }
+
+    // Запись ребра во все представления графа
+    void storeEdge(int u, int v) {
+        if (!adjMatrix.empty()) adjMatrix[u][v] = 1;
+        adjList[u].push_back(v);
+        edges.push_back({u, v});
+
+        // Если граф направленный, то добавляем ребро только в одну сторону
+        if (directed) {
+            reverseAdjList[v].push_back(u);
+        } else {
+            if (!adjMatrix.empty()) adjMatrix[v][u] = 1;
+            adjList[v].push_back(u);
+            edges.push_back({v, u});
+        }
+    }
+
+    // Входящие рёбра вершины: для неориентированного графа совпадают с исходящими
+    const vector<vector<int>>& inNeighbors() const {
+        return directed ? reverseAdjList : adjList;
+    }
+
+    // Восстановление и вывод пути по массиву предков
+    void printPath(const char* label, const vector<int>& parent, int end) {
+        vector<int> path;
+        for (int v = end; v != -1; v = parent[v]) {
+            path.push_back(v);
+        }
+        reverse(path.begin(), path.end());
+        printPath(label, path);
+    }
+
+    void printPath(const char* label, const vector<int>& path) {
+        lastPathLength = path.size() - 1;
+        if (!verbose) return;
+        cout << "Path (" << label << "): ";
+        for (int v : path) {
+            cout << getOriginalId(v) << " ";
+        }
+        cout << endl;
+    }
 
 public:
     // Конструктор с параметрами генерации графа
@@ -29,147 +743,1296 @@ public:
         directed = isDirected;
 
         // Инициализация структуры данных
-        adjMatrix.resize(numVertices, vector<int>(numVertices, 0));
-        adjList.resize(numVertices);
+        allocate();
 
         generateGraph(maxEdgesPerVertex);
     }
 
-    // Генерация графа
-    void generateGraph(int maxEdgesPerVertex) {
-        int edgeCount = 0;
-
-        while (edgeCount < numEdges) {
-            int u = rand() % numVertices;
-            int v = rand() % numVertices;
-            
-            // Проверка на существование ребра (чтобы не дублировать рёбра)
-            if (u != v && adjMatrix[u][v] == 0) {
-                adjMatrix[u][v] = 1;
-                adjList[u].push_back(v);
+    // Конструктор по готовому списку рёбер, например из GraphGenerator
+    // (для больших графов матрица смежности не строится)
+    RandomGraph(int vertices, const vector<pair<int, int>>& edgeList, bool isDirected) {
+        numVertices = vertices;
+        numEdges = edgeList.size();
+        directed = isDirected;
+
+        allocate();
+        edges.reserve(directed ? edgeList.size() : 2 * edgeList.size());
+        for (auto& edge : edgeList) {
+            storeEdge(edge.first, edge.second);
+        }
+    }
+
+    // Конструктор по графу из двоичного файла: строки CSR копируются в списки смежности целиком.
+    // Нужен, когда требуются все представления RandomGraph; для поиска путей по файлу без копии
+    // см. mappedBfs, mappedDfs, mappedDijkstra
+    explicit RandomGraph(const MappedGraph& file) {
+        numVertices = file.getNumVertices();
+        directed = file.isDirected();
+        numEdges = directed ? file.getNumArcs() : file.getNumArcs() / 2;
+
+        allocate();
+        edges.reserve(file.getNumArcs());
+        if (file.isWeighted()) weightList.resize(numVertices);
+        for (int u = 0; u < numVertices; ++u) {
+            adjList[u].assign(file.neighborsBegin(u), file.neighborsEnd(u));
+            if (file.isWeighted()) weightList[u].assign(file.weightsBegin(u), file.weightsBegin(u) + adjList[u].size());
+            for (int v : adjList[u]) {
+                if (!adjMatrix.empty()) adjMatrix[u][v] = 1;
+                if (directed) reverseAdjList[v].push_back(u);
                 edges.push_back({u, v});
+            }
+        }
+    }
+
+    // Сохранение графа в двоичном формате (с весами, если они заданы)
+    void saveBinary(const string& path) {
+        size_t arcs = edges.size();
+        bool weighted = isWeighted();
+        size_t size = sizeof(GraphFileHeader) + (numVertices + 1) * sizeof(uint64_t)
+                      + arcs * sizeof(int32_t) * (weighted ? 2 : 1);
+        char* data = mapOutputFile(path, size);
+
+        GraphFileHeader* header = reinterpret_cast<GraphFileHeader*>(data);
+        memcpy(header->magic, "GRPH", 4);
+        header->version = graphFileVersion;
+        header->flags = (directed ? graphFileDirected : 0) | (weighted ? graphFileWeighted : 0);
+        header->reserved = 0;
+        header->numVertices = numVertices;
+        header->numArcs = arcs;
+
+        uint64_t* offsets = reinterpret_cast<uint64_t*>(header + 1);
+        int32_t* targets = reinterpret_cast<int32_t*>(offsets + numVertices + 1);
+        int32_t* weights = targets + arcs;
+        offsets[0] = 0;
+        for (int u = 0; u < numVertices; ++u) {
+            copy(adjList[u].begin(), adjList[u].end(), targets + offsets[u]);
+            if (weighted) copy(weightList[u].begin(), weightList[u].end(), weights + offsets[u]);
+            offsets[u + 1] = offsets[u] + adjList[u].size();
+        }
+
+        munmap(data, size);
+    }
+
+    // Генерация графа: G(n, m) с не более чем maxEdgesPerVertex рёбрами у вершины
+    // (если столько рёбер не помещается, их становится меньше)
+    void generateGraph(int maxEdgesPerVertex) {
+        GraphGenerator generator(numVertices, directed, maxEdgesPerVertex, rand());
+        vector<pair<int, int>> edgeList = generator.erdosRenyiGnm(numEdges);
+
+        numEdges = edgeList.size();
+        for (auto& edge : edgeList) {
+            storeEdge(edge.first, edge.second);
+        }
+    }
+
+    // Метод для поиска кратчайшего пути с помощью поиска в ширину (BFS).
+    // Путь из вершины в неё саму — одна вершина (длина 0), как у всех вариантов BFS и у DFS
+    bool bfs(int start, int end) {
+        lastVisitedCount = 1;
+        lastPathLength = -1;
+        if (start == end) {
+            printPath("BFS", vector<int>{start});
+            return true;
+        }
+
+        vector<bool> visited(numVertices, false);
+        vector<int> parent(numVertices, -1);
+        queue<int> q;
+
+        visited[start] = true;
+        q.push(start);
+
+        while (!q.empty()) {
+            int vertex = q.front();
+            q.pop();
+
+            for (int neighbor : adjList[vertex]) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    parent[neighbor] = vertex;
+                    ++lastVisitedCount;
+                    q.push(neighbor);
+
+                    if (neighbor == end) {
+                        printPath("BFS", parent, end);
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // Двунаправленный BFS для запроса start -> end: поиск ведётся одновременно от начала по исходящим
+    // рёбрам и от конца по входящим, каждый раз расширяется целый уровень меньшего из двух фронтов
+    bool bfsBidirectional(int start, int end) {
+        lastPathLength = -1;
+        lastVisitedCount = 1;
+        if (start == end) {
+            printPath("Bidirectional BFS", vector<int>{start});
+            return true;
+        }
 
-                // Если граф направленный, то добавляем ребро только в одну сторону
-                if (!directed) {
-                    adjMatrix[v][u] = 1;
-                    adjList[v].push_back(u);
-                    edges.push_back({v, u});
+        vector<int> distForward(numVertices, -1), distBackward(numVertices, -1);
+        vector<int> parentForward(numVertices, -1), parentBackward(numVertices, -1);
+        vector<int> frontForward = {start}, frontBackward = {end}, next;
+        distForward[start] = 0;
+        distBackward[end] = 0;
+        ++lastVisitedCount;
+
+        const vector<vector<int>>& in = inNeighbors();
+        int meet = -1, best = INT_MAX;
+
+        while (!frontForward.empty() && !frontBackward.empty()) {
+            bool forward = frontForward.size() <= frontBackward.size();
+            vector<int>& front = forward ? frontForward : frontBackward;
+            vector<int>& dist = forward ? distForward : distBackward;
+            vector<int>& otherDist = forward ? distBackward : distForward;
+            vector<int>& parent = forward ? parentForward : parentBackward;
+            const vector<vector<int>>& neighbors = forward ? adjList : in;
+
+            // Уровень дорабатывается целиком, чтобы среди всех встреч выбрать кратчайшую
+            next.clear();
+            for (int u : front) {
+                for (int v : neighbors[u]) {
+                    if (otherDist[v] != -1 && dist[u] + 1 + otherDist[v] < best) {
+                        best = dist[u] + 1 + otherDist[v];
+                        meet = v;
+                        if (dist[v] == -1) parent[v] = u;
+                    }
+                    if (dist[v] == -1) {
+                        dist[v] = dist[u] + 1;
+                        parent[v] = u;
+                        next.push_back(v);
+                        if (otherDist[v] == -1) ++lastVisitedCount;
+                    }
                 }
+            }
+            front.swap(next);
+
+            if (meet != -1) break;
+        }
+
+        if (meet == -1) return false;
+
+        // Путь start -> meet по прямым предкам и meet -> end по обратным; если встреча случилась
+        // на ребре (u, meet) из фронта, дошедшего до meet вторым, предок meet взят с этого ребра
+        vector<int> path;
+        for (int v = meet; v != -1; v = parentForward[v]) {
+            path.push_back(v);
+        }
+        reverse(path.begin(), path.end());
+        for (int v = parentBackward[meet]; v != -1; v = parentBackward[v]) {
+            path.push_back(v);
+        }
+        printPath("Bidirectional BFS", path);
+        return true;
+    }
+
+    // Пакетные запросы расстояний: BFS сразу из многих источников (MS-BFS, Then et al.).
+    // У каждой вершины есть битовые маски источников: seen — уже дошли, visit — во фронте.
+    // Один проход по рёбрам продвигает все 64 * Words источника пакета сразу; при Words = 4
+    // циклы по словам маски компилятор разворачивает в 256-битные операции.
+    // Результат: dist[i][j] — число рёбер от sources[i] до targets[j] или -1, если пути нет
+    template <int Words = 1>
+    vector<vector<int>> multiSourceDistances(const vector<int>& sources, const vector<int>& targets) {
+        const int batchSize = 64 * Words;
+        struct Mask {
+            uint64_t bits[Words];
+        };
+
+        vector<vector<int>> dist(sources.size(), vector<int>(targets.size(), -1));
+        vector<vector<int>> targetIndex(numVertices);
+        for (int j = 0; j < (int)targets.size(); ++j) {
+            targetIndex[targets[j]].push_back(j);
+        }
+
+        vector<Mask> seen(numVertices), visit(numVertices), visitNext(numVertices);
+
+        for (size_t first = 0; first < sources.size(); first += batchSize) {
+            int count = min((size_t)batchSize, sources.size() - first);
+            fill(seen.begin(), seen.end(), Mask{});
+            fill(visit.begin(), visit.end(), Mask{});
+
+            for (int i = 0; i < count; ++i) {
+                int s = sources[first + i];
+                seen[s].bits[i / 64] |= 1ULL << (i % 64);
+                visit[s].bits[i / 64] |= 1ULL << (i % 64);
+                for (int j : targetIndex[s]) dist[first + i][j] = 0;
+            }
+
+            bool active = true;
+            for (int level = 1; active; ++level) {
+                active = false;
+                fill(visitNext.begin(), visitNext.end(), Mask{});
+
+                for (int v = 0; v < numVertices; ++v) {
+                    uint64_t any = 0;
+                    for (int w = 0; w < Words; ++w) any |= visit[v].bits[w];
+                    if (!any) continue;
+
+                    for (int n : adjList[v]) {
+                        uint64_t fresh = 0;
+                        for (int w = 0; w < Words; ++w) {
+                            uint64_t d = visit[v].bits[w] & ~seen[n].bits[w];
+                            visitNext[n].bits[w] |= d;
+                            seen[n].bits[w] |= d;
+                            fresh |= d;
+                        }
+                        if (!fresh || targetIndex[n].empty()) continue;
+
+                        // Новые источники, впервые дошедшие до целевой вершины n
+                        for (int w = 0; w < Words; ++w) {
+                            uint64_t d = visit[v].bits[w] & visitNext[n].bits[w];
+                            for (; d; d &= d - 1) {
+                                int i = w * 64 + __builtin_ctzll(d);
+                                for (int j : targetIndex[n]) {
+                                    if (dist[first + i][j] == -1) dist[first + i][j] = level;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                for (int v = 0; v < numVertices && !active; ++v) {
+                    for (int w = 0; w < Words; ++w) active |= visitNext[v].bits[w] != 0;
+                }
+                visit.swap(visitNext);
+            }
+        }
+
+        return dist;
+    }
+
+    // Случайные веса рёбер от 1 до maxWeight. Вес вычисляется по паре концов, поэтому у
+    // неориентированного ребра он одинаков в обе стороны и не зависит от порядка рёбер
+    void assignRandomWeights(int maxWeight, unsigned long long seed) {
+        weightList.assign(numVertices, vector<int>());
+        for (int u = 0; u < numVertices; ++u) {
+            weightList[u].resize(adjList[u].size());
+            for (size_t k = 0; k < adjList[u].size(); ++k) {
+                int v = adjList[u][k];
+                unsigned long long a = directed ? u : min(u, v), b = directed ? v : max(u, v);
+                weightList[u][k] = 1 + GraphGenerator::mix(seed ^ (a << 32 | b)) % maxWeight;
+            }
+        }
+    }
+
+    bool isWeighted() const {
+        return !weightList.empty();
+    }
+
+    // Вес ребра в позиции k списка смежности вершины u (1 для невзвешенного графа)
+    int edgeWeight(int u, size_t k) const {
+        return weightList.empty() ? 1 : weightList[u][k];
+    }
+
+    // Наибольший вес ребра (1 для невзвешенного графа, 0 для графа без рёбер)
+    int maxEdgeWeight() const {
+        int result = 0;
+        for (int u = 0; u < numVertices; ++u) {
+            for (size_t k = 0; k < adjList[u].size(); ++k) result = max(result, edgeWeight(u, k));
+        }
+        return result;
+    }
+
+    // Алгоритм Дейкстры с подключаемой очередью с приоритетом (см. LazyBinaryHeap, IndexedDaryHeap,
+    // BucketQueue). Возвращает расстояния от source, -1 для недостижимых вершин
+    template <typename Queue, typename... QueueArgs>
+    vector<long long> dijkstra(int source, QueueArgs... queueArgs) {
+        vector<long long> dist(numVertices, LLONG_MAX);
+        Queue queue(numVertices, queueArgs...);
+        if constexpr (is_same<Queue, BucketQueue>::value) {
+            // Ребро тяжелее maxWeight положит вершину в ещё не пройденную корзину по модулю,
+            // и она извлечётся раньше вершин с меньшим расстоянием
+            if (maxEdgeWeight() > queue.maxWeight()) {
+                throw invalid_argument("BucketQueue: edge weight " + to_string(maxEdgeWeight()) +
+                                       " exceeds maxWeight " + to_string(queue.maxWeight()));
+            }
+        }
+        lastRelaxations = 0;
+
+        dist[source] = 0;
+        queue.push(source, 0);
+        while (!queue.empty()) {
+            auto top = queue.pop();
+            int u = top.first;
+            if (top.second > dist[u]) continue;
+
+            for (size_t k = 0; k < adjList[u].size(); ++k) {
+                int v = adjList[u][k];
+                long long candidate = dist[u] + edgeWeight(u, k);
+                ++lastRelaxations;
+                if (candidate < dist[v]) {
+                    dist[v] = candidate;
+                    queue.push(v, candidate);
+                }
+            }
+        }
+
+        for (auto& d : dist) {
+            if (d == LLONG_MAX) d = -1;
+        }
+        return dist;
+    }
+
+    // Многопоточный delta-stepping (Meyer, Sanders). Вершины лежат в корзинах по floor(dist / delta).
+    // Корзина с наименьшим номером обрабатывается фазами: параллельно релаксируются лёгкие рёбра
+    // (вес <= delta), пока корзина не перестанет пополняться, затем один раз тяжёлые рёбра всех
+    // вершин, прошедших через корзину. Расстояния уменьшаются атомарным CAS, а улучшенные вершины
+    // каждый поток копит в своём списке, откуда они раскладываются по корзинам между фазами
+    vector<long long> deltaStepping(int source, int delta, int numThreads) {
+        // delta — делитель номера корзины: при delta <= 0 деление на ноль или отрицательные номера
+        if (delta <= 0) {
+            throw invalid_argument("deltaStepping: delta must be positive, got " + to_string(delta));
+        }
+
+        vector<atomic<long long>> dist(numVertices);
+        for (int v = 0; v < numVertices; ++v) {
+            dist[v].store(LLONG_MAX, memory_order_relaxed);
+        }
+        dist[source].store(0, memory_order_relaxed);
+
+        vector<vector<int>> buckets(1, vector<int>{source});
+        vector<vector<int>> localRequests(numThreads);
+        vector<long long> localRelaxations(numThreads, 0);
+        vector<int> stamp(numVertices, -1);
+        const size_t chunkSize = 64;
+
+        // Релаксация лёгких или тяжёлых рёбер вершин frontier
+        auto relax = [&](const vector<int>& frontier, bool light) {
+            for (auto& local : localRequests) local.clear();
+
+            parallelChunks(frontier.size(), numThreads, chunkSize, [&](int id, size_t begin, size_t finish) {
+                vector<int>& local = localRequests[id];
+                for (size_t i = begin; i < finish; ++i) {
+                    int u = frontier[i];
+                    long long du = dist[u].load(memory_order_relaxed);
+                    for (size_t k = 0; k < adjList[u].size(); ++k) {
+                        int w = edgeWeight(u, k);
+                        if ((w <= delta) != light) continue;
+
+                        int v = adjList[u][k];
+                        long long candidate = du + w;
+                        long long current = dist[v].load(memory_order_relaxed);
+                        ++localRelaxations[id];
+                        while (candidate < current) {
+                            if (dist[v].compare_exchange_weak(current, candidate, memory_order_relaxed)) {
+                                local.push_back(v);
+                                break;
+                            }
+                        }
+                    }
+                }
+            });
+
+            for (auto& local : localRequests) {
+                for (int v : local) {
+                    size_t b = dist[v].load(memory_order_relaxed) / delta;
+                    if (b >= buckets.size()) buckets.resize(b + 1);
+                    buckets[b].push_back(v);
+                }
+            }
+        };
+
+        int phase = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            vector<int> settled;
+
+            while (!buckets[i].empty()) {
+                // Текущее содержимое корзины без устаревших записей и повторов
+                vector<int> frontier;
+                for (int v : buckets[i]) {
+                    if (stamp[v] != phase && (size_t)(dist[v].load(memory_order_relaxed) / delta) == i) {
+                        stamp[v] = phase;
+                        frontier.push_back(v);
+                    }
+                }
+                buckets[i].clear();
+                ++phase;
+
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+                relax(frontier, true);
+            }
+
+            sort(settled.begin(), settled.end());
+            settled.erase(unique(settled.begin(), settled.end()), settled.end());
+            relax(settled, false);
+            vector<int>().swap(buckets[i]);
+        }
+
+        lastRelaxations = 0;
+        for (long long r : localRelaxations) lastRelaxations += r;
+
+        vector<long long> result(numVertices);
+        for (int v = 0; v < numVertices; ++v) {
+            long long d = dist[v].load(memory_order_relaxed);
+            result[v] = d == LLONG_MAX ? -1 : d;
+        }
+        return result;
+    }
+
+    long long getLastRelaxations() const { return lastRelaxations; }
+
+    int getLastPathLength() const { return lastPathLength; }
+    int getLastVisitedCount() const { return lastVisitedCount; }
+
+    // Настройка порогов переключения направления для bfsDirectionOptimizing
+    void setDirectionThresholds(int alpha, int beta) {
+        doAlpha = alpha;
+        doBeta = beta;
+    }
+
+    int getAlpha() const { return doAlpha; }
+    int getBeta() const { return doBeta; }
+
+    void setVerbose(bool value) {
+        verbose = value;
+    }
+
+    // BFS с оптимизацией направления: пока фронт мал, идём сверху вниз (от фронта к соседям),
+    // а на широких средних уровнях ищем для каждой непосещённой вершины предка во фронте (снизу вверх)
+    bool bfsDirectionOptimizing(int start, int end) {
+        vector<int> parent(numVertices, -1);
+        vector<bool> visited(numVertices, false);
+        vector<bool> inFrontier(numVertices, false);
+        vector<int> frontier, next;
+
+        visited[start] = true;
+        frontier.push_back(start);
+
+        // Сумма степеней ещё не посещённых вершин (в edges хранится каждое исходящее ребро)
+        long long frontierEdges = adjList[start].size();
+        long long unexploredEdges = (long long)edges.size() - frontierEdges;
+        bool bottomUp = false;
+
+        while (!frontier.empty() && !visited[end]) {
+            if (!bottomUp && frontierEdges > unexploredEdges / doAlpha) {
+                bottomUp = true;
+            } else if (bottomUp && (long long)frontier.size() * doBeta < numVertices) {
+                bottomUp = false;
+            }
+
+            next.clear();
+            frontierEdges = 0;
+
+            if (bottomUp) {
+                for (int v : frontier) inFrontier[v] = true;
+
+                // Сначала проверяем саму цель: если её предок уже во фронте, остальной уровень не нужен
+                const vector<vector<int>>& in = inNeighbors();
+                for (int u : in[end]) {
+                    if (inFrontier[u]) {
+                        visited[end] = true;
+                        parent[end] = u;
+                        break;
+                    }
+                }
+
+                for (int v = 0; v < numVertices && !visited[end]; ++v) {
+                    if (visited[v]) continue;
+                    for (int u : in[v]) {
+                        if (inFrontier[u]) {
+                            visited[v] = true;
+                            parent[v] = u;
+                            next.push_back(v);
+                            break;
+                        }
+                    }
+                }
+
+                for (int v : frontier) inFrontier[v] = false;
+            } else {
+                for (int u : frontier) {
+                    for (int v : adjList[u]) {
+                        if (!visited[v]) {
+                            visited[v] = true;
+                            parent[v] = u;
+                            next.push_back(v);
+                        }
+                    }
+                    if (visited[end]) break;
+                }
+            }
+
+            for (int v : next) {
+                frontierEdges += adjList[v].size();
+            }
+            unexploredEdges -= frontierEdges;
+            frontier.swap(next);
+        }
+
+        if (!visited[end]) return false;
+        printPath("DO-BFS", parent, end);
+        return true;
+    }
+
+    // Многопоточный BFS по уровням: потоки разбирают фронт порциями, каждый складывает найденные
+    // вершины в свой локальный следующий фронт, а вершину «захватывает» тот, чей CAS по level успешен
+    bool bfsParallel(int start, int end, int numThreads) {
+        vector<atomic<int>> level(numVertices);
+        for (int v = 0; v < numVertices; ++v) {
+            level[v].store(-1, memory_order_relaxed);
+        }
+        level[start].store(0, memory_order_relaxed);
+
+        vector<int> frontier = {start};
+        vector<vector<int>> localNext(numThreads);
+        const int chunkSize = 256;
+        int depth = 0;
+
+        while (!frontier.empty() && level[end].load(memory_order_relaxed) == -1) {
+            for (auto& local : localNext) {
+                local.clear();
+            }
+
+            parallelChunks(frontier.size(), numThreads, chunkSize, [&](int id, size_t begin, size_t finish) {
+                vector<int>& local = localNext[id];
+                for (size_t i = begin; i < finish; ++i) {
+                    for (int v : adjList[frontier[i]]) {
+                        if (level[v].load(memory_order_relaxed) != -1) continue;
+                        int expected = -1;
+                        if (level[v].compare_exchange_strong(expected, depth + 1, memory_order_relaxed)) {
+                            local.push_back(v);
+                        }
+                    }
+                }
+            });
+
+            frontier.clear();
+            for (auto& local : localNext) {
+                frontier.insert(frontier.end(), local.begin(), local.end());
+            }
+            ++depth;
+        }
+
+        if (level[end].load(memory_order_relaxed) == -1) return false;
+
+        // Детерминированное восстановление пути: из каждой вершины идём в предшественника
+        // с наименьшим номером на предыдущем уровне, независимо от того, какой поток её захватил
+        vector<int> parent(numVertices, -1);
+        const vector<vector<int>>& in = inNeighbors();
+        for (int v = end; v != start; v = parent[v]) {
+            int need = level[v].load(memory_order_relaxed) - 1;
+            for (int u : in[v]) {
+                if (level[u].load(memory_order_relaxed) == need && (parent[v] == -1 || u < parent[v])) {
+                    parent[v] = u;
+                }
+            }
+        }
+        printPath("Parallel BFS", parent, end);
+        return true;
+    }
+
+    // Метод для поиска пути с помощью поиска в глубину (DFS). Рекурсия заменена явным стеком кадров
+    // (вершина, индекс следующего соседа): стек одновременно является текущим путём от start,
+    // поэтому глубина пути ограничена только памятью, а не стеком вызовов
+    bool dfs(int start, int end) {
+        vector<bool> visited(numVertices, false);
+        vector<pair<int, int>> stack;
+        lastPathLength = -1;
+
+        visited[start] = true;
+        stack.push_back({start, 0});
+
+        while (!stack.empty()) {
+            int vertex = stack.back().first;
+
+            if (vertex == end) {
+                vector<int> path;
+                path.reserve(stack.size());
+                for (auto& frame : stack) {
+                    path.push_back(frame.first);
+                }
+                printPath("DFS", path);
+                return true;
+            }
+
+            // Ищем следующего непосещённого соседа, продолжая с места остановки
+            int& next = stack.back().second;
+            const vector<int>& neighbors = adjList[vertex];
+            while (next < (int)neighbors.size() && visited[neighbors[next]]) {
+                ++next;
+            }
+
+            if (next == (int)neighbors.size()) {
+                stack.pop_back();
+            } else {
+                int neighbor = neighbors[next++];
+                visited[neighbor] = true;
+                stack.push_back({neighbor, 0});
+            }
+        }
+
+        return false;
+    }
+
+    // Метод для вызова DFS
+    bool dfsWrapper(int start, int end) {
+        return dfs(start, end);
+    }
+
+    // Методы для получения представлений графа
+    vector<vector<int>> getAdjMatrix() {
+        return adjMatrix;
+    }
+
+    vector<vector<int>> getAdjList() {
+        return adjList;
+    }
+
+    vector<pair<int, int>> getEdges() {
+        return edges;
+    }
+
+    int getNumVertices() const {
+        return numVertices;
+    }
+
+    bool isDirected() const {
+        return directed;
+    }
+
+    const vector<int>& neighbors(int v) const {
+        return adjList[v];
+    }
+
+    // Перенумерация вершин для локальности памяти: списки смежности, веса, рёбра и матрица
+    // переписываются под новые номера, а списки соседей сортируются. Соответствие с исходными
+    // номерами сохраняется (getOriginalId/getInternalId), пути печатаются в исходных номерах
+    void reorder(VertexOrder order) {
+        vector<int> sequence = vertexSequence(order);  // sequence[новый номер] = текущий номер
+        vector<int> newId(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            newId[sequence[i]] = i;
+        }
+
+        vector<vector<int>> newAdjList(numVertices), newWeights(weightList.empty() ? 0 : numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            int old = sequence[i];
+            vector<pair<int, int>> row;
+            row.reserve(adjList[old].size());
+            for (size_t k = 0; k < adjList[old].size(); ++k) {
+                row.push_back({newId[adjList[old][k]], edgeWeight(old, k)});
+            }
+            sort(row.begin(), row.end());
+
+            for (auto& entry : row) {
+                newAdjList[i].push_back(entry.first);
+                if (!newWeights.empty()) newWeights[i].push_back(entry.second);
+            }
+        }
+        adjList.swap(newAdjList);
+        weightList.swap(newWeights);
+
+        if (directed) {
+            for (auto& row : reverseAdjList) row.clear();
+            for (int u = 0; u < numVertices; ++u) {
+                for (int v : adjList[u]) reverseAdjList[v].push_back(u);
+            }
+        }
+        for (auto& edge : edges) {
+            edge = {newId[edge.first], newId[edge.second]};
+        }
+        if (!adjMatrix.empty()) {
+            for (auto& row : adjMatrix) fill(row.begin(), row.end(), 0);
+            for (auto& edge : edges) adjMatrix[edge.first][edge.second] = 1;
+        }
+
+        vector<int> newOriginal(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            newOriginal[i] = getOriginalId(sequence[i]);
+        }
+        originalIds.swap(newOriginal);
+        internalIds.assign(numVertices, 0);
+        for (int i = 0; i < numVertices; ++i) {
+            internalIds[originalIds[i]] = i;
+        }
+
+        if (dynamicMode) enableDynamic();
+    }
+
+    // Включение динамического режима: индекс положений дуг и начальные компоненты связности.
+    // addEdge/removeEdge включают его сами при первом вызове. Граф должен быть без кратных рёбер
+    void enableDynamic() {
+        dynamicMode = true;
+        arcIndex.clear();
+        arcIndex.reserve(edges.size());
+        for (int u = 0; u < numVertices; ++u) {
+            for (size_t k = 0; k < adjList[u].size(); ++k) {
+                arcIndex[arcKey(u, adjList[u][k])] = {(int)k, -1, -1};
+            }
+        }
+        for (int v = 0; directed && v < numVertices; ++v) {
+            for (size_t k = 0; k < reverseAdjList[v].size(); ++k) {
+                arcIndex[arcKey(reverseAdjList[v][k], v)].rev = k;
+            }
+        }
+        for (size_t i = 0; i < edges.size(); ++i) {
+            arcIndex[arcKey(edges[i].first, edges[i].second)].edge = i;
+        }
+
+        componentOf.assign(numVertices, -1);
+        componentMembers.clear();
+        memberPos.assign(numVertices, 0);
+        freeComponentIds.clear();
+        numComponents = 0;
+        searchMark.assign(numVertices, 0);
+        searchStamp = 0;
+
+        for (int root = 0; root < numVertices; ++root) {
+            if (componentOf[root] != -1) continue;
+            int id = componentMembers.size();
+            componentMembers.push_back({root});
+            componentOf[root] = id;
+            ++numComponents;
+            for (size_t head = 0; head < componentMembers[id].size(); ++head) {
+                int x = componentMembers[id][head];
+                memberPos[x] = head;
+                forEachUndirectedNeighbor(x, [&](int y) {
+                    if (componentOf[y] == -1) {
+                        componentOf[y] = id;
+                        componentMembers[id].push_back(y);
+                    }
+                    return true;
+                });
+            }
+        }
+    }
+
+    // Добавление ребра u -> v (для неориентированного графа — в обе стороны).
+    // Возвращает false для петли или уже существующего ребра
+    bool addEdge(int u, int v, int weight = 1) {
+        if (!dynamicMode) enableDynamic();
+        if (u == v || arcIndex.count(arcKey(u, v))) return false;
+
+        insertArc(u, v, weight);
+        if (!directed) insertArc(v, u, weight);
+        ++numEdges;
+
+        // Слияние компонент: вершины меньшей переходят в большую
+        int a = componentOf[u], b = componentOf[v];
+        if (a != b) {
+            if (componentMembers[a].size() < componentMembers[b].size()) swap(a, b);
+            for (int x : componentMembers[b]) {
+                componentOf[x] = a;
+                memberPos[x] = componentMembers[a].size();
+                componentMembers[a].push_back(x);
+            }
+            vector<int>().swap(componentMembers[b]);
+            freeComponentIds.push_back(b);
+            --numComponents;
+        }
+        return true;
+    }
+
+    // Удаление ребра u -> v. Если это был мост, компонента делится: встречные обходы от u и от v
+    // идут по одной вершине попеременно, и первый исчерпавший свою часть обход выделяет её
+    // в новую компоненту — работа пропорциональна меньшей из частей
+    bool removeEdge(int u, int v) {
+        if (!dynamicMode) enableDynamic();
+        if (!arcIndex.count(arcKey(u, v))) return false;
+
+        eraseArc(u, v);
+        if (!directed) eraseArc(v, u);
+        --numEdges;
+
+        // В ориентированном графе связь через обратную дугу v -> u сохраняется
+        if (directed && arcIndex.count(arcKey(v, u))) return true;
+
+        searchStamp += 2;
+        vector<int> side[2] = {{u}, {v}};
+        size_t head[2] = {0, 0};
+        searchMark[u] = searchStamp;
+        searchMark[v] = searchStamp + 1;
+
+        while (true) {
+            for (int s = 0; s < 2; ++s) {
+                if (head[s] == side[s].size()) {
+                    splitComponent(side[s]);
+                    return true;
+                }
+                int x = side[s][head[s]++];
+                bool met = false;
+                forEachUndirectedNeighbor(x, [&](int y) {
+                    if (searchMark[y] == searchStamp + (1 - s)) {
+                        met = true;
+                        return false;
+                    }
+                    if (searchMark[y] != searchStamp + s) {
+                        searchMark[y] = searchStamp + s;
+                        side[s].push_back(y);
+                    }
+                    return true;
+                });
+                if (met) return true;
+            }
+        }
+    }
+
+    // Связаны ли вершины (в динамическом режиме — за O(1))
+    bool connected(int u, int v) {
+        if (!dynamicMode) enableDynamic();
+        return componentOf[u] == componentOf[v];
+    }
+
+    int getNumComponents() {
+        if (!dynamicMode) enableDynamic();
+        return numComponents;
+    }
+
+    int getNumEdges() const {
+        return numEdges;
+    }
+
+    const vector<pair<int, int>>& edgeList() const {
+        return edges;
+    }
+
+private:
+    // Обход соседей без учёта направления; visit возвращает false, чтобы остановиться
+    template <typename Visit>
+    void forEachUndirectedNeighbor(int x, Visit visit) {
+        for (int y : adjList[x]) {
+            if (!visit(y)) return;
+        }
+        if (directed) {
+            for (int y : reverseAdjList[x]) {
+                if (!visit(y)) return;
+            }
+        }
+    }
+
+    void insertArc(int u, int v, int weight) {
+        ArcSlots slots = {(int)adjList[u].size(), directed ? (int)reverseAdjList[v].size() : -1, (int)edges.size()};
+        adjList[u].push_back(v);
+        if (!weightList.empty()) weightList[u].push_back(weight);
+        if (directed) reverseAdjList[v].push_back(u);
+        edges.push_back({u, v});
+        if (!adjMatrix.empty()) adjMatrix[u][v] = 1;
+        arcIndex[arcKey(u, v)] = slots;
+    }
+
+    // Удаление дуги обменом с последним элементом каждого списка и правкой положения перенесённой дуги
+    void eraseArc(int u, int v) {
+        auto it = arcIndex.find(arcKey(u, v));
+        ArcSlots slots = it->second;
+        arcIndex.erase(it);
+
+        int moved = adjList[u].back();
+        adjList[u][slots.adj] = moved;
+        adjList[u].pop_back();
+        if (!weightList.empty()) {
+            weightList[u][slots.adj] = weightList[u].back();
+            weightList[u].pop_back();
+        }
+        if (moved != v) arcIndex[arcKey(u, moved)].adj = slots.adj;
+
+        if (directed) {
+            int movedSource = reverseAdjList[v].back();
+            reverseAdjList[v][slots.rev] = movedSource;
+            reverseAdjList[v].pop_back();
+            if (movedSource != u) arcIndex[arcKey(movedSource, v)].rev = slots.rev;
+        }
+
+        pair<int, int> movedEdge = edges.back();
+        edges[slots.edge] = movedEdge;
+        edges.pop_back();
+        if (movedEdge != make_pair(u, v)) arcIndex[arcKey(movedEdge.first, movedEdge.second)].edge = slots.edge;
+
+        if (!adjMatrix.empty()) adjMatrix[u][v] = 0;
+    }
+
+    // Перенос вершин part из их компоненты в новую
+    void splitComponent(const vector<int>& part) {
+        int old = componentOf[part[0]];
+        int id;
+        if (freeComponentIds.empty()) {
+            id = componentMembers.size();
+            componentMembers.emplace_back();
+        } else {
+            id = freeComponentIds.back();
+            freeComponentIds.pop_back();
+        }
+
+        vector<int>& members = componentMembers[old];
+        for (int x : part) {
+            int last = members.back();
+            members[memberPos[x]] = last;
+            memberPos[last] = memberPos[x];
+            members.pop_back();
+
+            componentOf[x] = id;
+            memberPos[x] = componentMembers[id].size();
+            componentMembers[id].push_back(x);
+        }
+        ++numComponents;
+    }
+
+public:
+
+    // Перевод номеров между исходной и текущей нумерацией
+    int getOriginalId(int v) const {
+        return originalIds.empty() ? v : originalIds[v];
+    }
+
+    int getInternalId(int original) const {
+        return internalIds.empty() ? original : internalIds[original];
+    }
+
+private:
+    // Порядок вершин для reorder: sequence[новый номер] = текущий номер
+    vector<int> vertexSequence(VertexOrder order) {
+        vector<int> sequence(numVertices);
+        for (int v = 0; v < numVertices; ++v) sequence[v] = v;
+
+        if (order == VertexOrder::Degree) {
+            stable_sort(sequence.begin(), sequence.end(),
+                        [&](int a, int b) { return adjList[a].size() > adjList[b].size(); });
+            return sequence;
+        }
+
+        // BFS и Катхилл–Макки: обход в ширину по компонентам; для RCM корень компоненты — вершина
+        // наименьшей степени, соседи добавляются по возрастанию степени, а итог разворачивается
+        bool rcm = order == VertexOrder::ReverseCuthillMcKee;
+        vector<int> roots = sequence;
+        if (rcm) {
+            stable_sort(roots.begin(), roots.end(),
+                        [&](int a, int b) { return adjList[a].size() < adjList[b].size(); });
+        }
+
+        vector<bool> visited(numVertices, false);
+        vector<int> neighbors;
+        sequence.clear();
+        for (int root : roots) {
+            if (visited[root]) continue;
+            visited[root] = true;
+            size_t head = sequence.size();
+            sequence.push_back(root);
+
+            while (head < sequence.size()) {
+                int u = sequence[head++];
+                neighbors.clear();
+                for (int v : adjList[u]) {
+                    if (!visited[v]) {
+                        visited[v] = true;
+                        neighbors.push_back(v);
+                    }
+                }
+                if (rcm) {
+                    stable_sort(neighbors.begin(), neighbors.end(),
+                                [&](int a, int b) { return adjList[a].size() < adjList[b].size(); });
+                }
+                sequence.insert(sequence.end(), neighbors.begin(), neighbors.end());
+            }
+        }
+
+        if (rcm) reverse(sequence.begin(), sequence.end());
+        return sequence;
+    }
+
+public:
+
+    // Метод для отображения графа
+    void displayGraph() {
+        cout << "Adjacency Matrix: \n";
+        for (auto& row : adjMatrix) {
+            for (int val : row) {
+                cout << val << " ";
+            }
+            cout << endl;
+        }
+
+        cout << "Adjacency List: \n";
+        for (int i = 0; i < adjList.size(); ++i) {
+            cout << i << ": ";
+            for (int v : adjList[i]) {
+                cout << v << " ";
+            }
+            cout << endl;
+        }
+
+        cout << "Edges: \n";
+        for (auto& edge : edges) {
+            cout << edge.first << " -> " << edge.second << endl;
+        }
+    }
+};
+
+// Индекс достижимости для повторяющихся запросов «достижима ли end из start».
+// Граф сжимается по компонентам сильной связности (итеративный алгоритм Тарьяна) в DAG.
+// Тарьян нумерует компоненты в обратном топологическом порядке, поэтому ребро DAG всегда
+// ведёт в компоненту с меньшим номером, и comp[u] < comp[v] сразу означает «недостижима».
+// Если компонент не больше maxBitsetComponents, для каждой строится битовое множество
+// достижимых компонент и ответ получается за O(1). Иначе используются интервальные метки
+// GRAIL (несколько случайных обходов в глубину): непересечение интервалов отсекает большую
+// часть отрицательных запросов за O(1), вложенность по дереву первого обхода подтверждает
+// часть положительных, остальные досчитываются обходом DAG с теми же отсечениями.
+// Запросы не потокобезопасны: обход использует общий массив отметок
+class ReachabilityIndex {
+private:
+    static const int numIntervals = 2;
+    static const int maxBitsetComponents = 24000;
+
+    int numComponents = 0;
+    vector<int> comp;                   // Компонента сильной связности каждой вершины
+    vector<int> dagOffsets, dagTargets; // Рёбра DAG компонент в формате CSR
+    vector<int> low[numIntervals], post[numIntervals];
+    vector<int> pre;                    // Номер входа в первом обходе: вложенность [pre, post] по дереву обхода — точный положительный ответ
+    vector<uint64_t> closure;           // Построчные битовые множества достижимости
+    size_t words = 0;
+    vector<int> stamp;
+    int queryStamp = 0;
+
+    void findComponents(const RandomGraph& graph) {
+        int n = graph.getNumVertices();
+        comp.assign(n, -1);
+        vector<int> order(n, -1), lowLink(n, 0), stack;
+        vector<bool> onStack(n, false);
+        vector<pair<int, size_t>> calls;  // (вершина, индекс следующего соседа)
+        int counter = 0;
+
+        for (int root = 0; root < n; ++root) {
+            if (order[root] != -1) continue;
+            calls.push_back({root, 0});
+            order[root] = lowLink[root] = counter++;
+            stack.push_back(root);
+            onStack[root] = true;
+
+            while (!calls.empty()) {
+                int v = calls.back().first;
+                size_t& next = calls.back().second;
+                const vector<int>& adj = graph.neighbors(v);
+
+                if (next < adj.size()) {
+                    int w = adj[next++];
+                    if (order[w] == -1) {
+                        order[w] = lowLink[w] = counter++;
+                        stack.push_back(w);
+                        onStack[w] = true;
+                        calls.push_back({w, 0});
+                    } else if (onStack[w]) {
+                        lowLink[v] = min(lowLink[v], order[w]);
+                    }
+                    continue;
+                }
+
+                calls.pop_back();
+                if (!calls.empty()) {
+                    int parent = calls.back().first;
+                    lowLink[parent] = min(lowLink[parent], lowLink[v]);
+                }
+                if (lowLink[v] == order[v]) {
+                    while (true) {
+                        int w = stack.back();
+                        stack.pop_back();
+                        onStack[w] = false;
+                        comp[w] = numComponents;
+                        if (w == v) break;
+                    }
+                    ++numComponents;
+                }
+            }
+        }
+    }
 
-                edgeCount++;
+    void buildDag(const RandomGraph& graph) {
+        int n = graph.getNumVertices();
+        vector<pair<int, int>> dagEdges;
+        for (int u = 0; u < n; ++u) {
+            for (int v : graph.neighbors(u)) {
+                if (comp[u] != comp[v]) dagEdges.push_back({comp[u], comp[v]});
             }
         }
+        sort(dagEdges.begin(), dagEdges.end());
+        dagEdges.erase(unique(dagEdges.begin(), dagEdges.end()), dagEdges.end());
+
+        dagOffsets.assign(numComponents + 1, 0);
+        dagTargets.resize(dagEdges.size());
+        for (auto& edge : dagEdges) ++dagOffsets[edge.first + 1];
+        for (int c = 0; c < numComponents; ++c) dagOffsets[c + 1] += dagOffsets[c];
+        for (size_t i = 0; i < dagEdges.size(); ++i) dagTargets[i] = dagEdges[i].second;
     }
 
-    // Метод для поиска кратчайшего пути с помощью поиска в ширину (BFS)
-    bool bfs(int start, int end) {
-        vector<bool> visited(numVertices, false);
-        vector<int> parent(numVertices, -1);
-        queue<int> q;
+    // Метки GRAIL: post — номер компоненты в обратном порядке обхода со случайным порядком детей,
+    // low — минимум post по всем потомкам. Из c достижима d только если [low d, post d] внутри [low c, post c]
+    void buildIntervals(unsigned seed) {
+        mt19937 rng(seed);
+        vector<bool> isRoot(numComponents, true);
+        for (int t : dagTargets) isRoot[t] = false;
 
-        visited[start] = true;
-        q.push(start);
+        for (int k = 0; k < numIntervals; ++k) {
+            vector<int>& lowK = low[k];
+            vector<int>& postK = post[k];
+            lowK.assign(numComponents, -1);
+            postK.assign(numComponents, -1);
+            if (k == 0) pre.assign(numComponents, -1);
 
-        while (!q.empty()) {
-            int vertex = q.front();
-            q.pop();
+            vector<int> roots;
+            for (int c = 0; c < numComponents; ++c) {
+                if (isRoot[c]) roots.push_back(c);
+            }
+            shuffle(roots.begin(), roots.end(), rng);
 
-            for (int neighbor : adjList[vertex]) {
-                if (!visited[neighbor]) {
-                    visited[neighbor] = true;
-                    parent[neighbor] = vertex;
-                    q.push(neighbor);
+            vector<int> children;
+            vector<pair<int, int>> calls;  // (компонента, индекс следующего ребра в перемешанном списке)
+            vector<int> shuffled(dagTargets);
+            for (int c = 0; c < numComponents; ++c) {
+                shuffle(shuffled.begin() + dagOffsets[c], shuffled.begin() + dagOffsets[c + 1], rng);
+            }
 
-                    if (neighbor == end) {
-                        // Восстановление пути
-                        vector<int> path;
-                        for (int v = end; v != -1; v = parent[v]) {
-                            path.push_back(v);
+            int rank = 0, enter = 0;
+            for (int root : roots) {
+                calls.push_back({root, dagOffsets[root]});
+                lowK[root] = INT_MAX;
+                if (k == 0) pre[root] = enter++;
+                while (!calls.empty()) {
+                    int c = calls.back().first;
+                    int& next = calls.back().second;
+                    if (next < dagOffsets[c + 1]) {
+                        int d = shuffled[next++];
+                        if (postK[d] == -1 && lowK[d] == -1) {
+                            lowK[d] = INT_MAX;
+                            if (k == 0) pre[d] = enter++;
+                            calls.push_back({d, dagOffsets[d]});
                         }
-                        reverse(path.begin(), path.end());
-                        cout << "Path (BFS): ";
-                        for (int v : path) {
-                            cout << v << " ";
-                        }
-                        cout << endl;
-                        return true;
+                        continue;
                     }
+
+                    postK[c] = rank++;
+                    lowK[c] = min(lowK[c], postK[c]);
+                    for (int e = dagOffsets[c]; e < dagOffsets[c + 1]; ++e) {
+                        lowK[c] = min(lowK[c], lowK[dagTargets[e]]);
+                    }
+                    calls.pop_back();
                 }
             }
         }
+    }
 
-        return false;
+    // Полное транзитивное замыкание DAG: компоненты идут от стоков к истокам,
+    // так что множества всех потомков уже готовы
+    void buildClosure() {
+        words = (numComponents + 63) / 64;
+        closure.assign((size_t)numComponents * words, 0);
+        for (int c = 0; c < numComponents; ++c) {
+            uint64_t* row = &closure[(size_t)c * words];
+            row[c / 64] |= 1ULL << (c % 64);
+            for (int e = dagOffsets[c]; e < dagOffsets[c + 1]; ++e) {
+                const uint64_t* child = &closure[(size_t)dagTargets[e] * words];
+                for (size_t w = 0; w <= (size_t)dagTargets[e] / 64; ++w) row[w] |= child[w];
+            }
+        }
     }
 
-    // Метод для поиска кратчайшего пути с помощью поиска в глубину (DFS)
-    bool dfs(int start, int end, vector<bool>& visited, vector<int>& path) {
-        visited[start] = true;
-        path.push_back(start);
+    // d — потомок c в дереве первого обхода, значит достижима
+    bool treeReach(int c, int d) const {
+        return pre[c] <= pre[d] && post[0][d] <= post[0][c];
+    }
 
-        if (start == end) {
-            cout << "Path (DFS): ";
-            for (int v : path) {
-                cout << v << " ";
-            }
-            cout << endl;
-            return true;
+    bool mayReach(int c, int d) const {
+        if (c < d) return false;
+        for (int k = 0; k < numIntervals; ++k) {
+            if (low[k][d] < low[k][c] || post[k][d] > post[k][c]) return false;
         }
+        return true;
+    }
 
-        for (int neighbor : adjList[start]) {
-            if (!visited[neighbor]) {
-                if (dfs(neighbor, end, visited, path)) {
-                    return true;
+public:
+    explicit ReachabilityIndex(const RandomGraph& graph, unsigned seed = 1) {
+        findComponents(graph);
+        buildDag(graph);
+        if (numComponents <= maxBitsetComponents) {
+            buildClosure();
+        } else {
+            buildIntervals(seed);
+            stamp.assign(numComponents, 0);
+        }
+    }
+
+    bool reachable(int start, int end) {
+        int c = comp[start], d = comp[end];
+        if (c == d) return true;
+        if (!closure.empty()) return closure[(size_t)c * words + d / 64] >> (d % 64) & 1;
+        if (!mayReach(c, d)) return false;
+        if (treeReach(c, d)) return true;
+
+        // Обход DAG только по компонентам, через которые d ещё может быть достижима
+        ++queryStamp;
+        vector<int> stack = {c};
+        stamp[c] = queryStamp;
+        while (!stack.empty()) {
+            int x = stack.back();
+            stack.pop_back();
+            for (int e = dagOffsets[x]; e < dagOffsets[x + 1]; ++e) {
+                int y = dagTargets[e];
+                if (y == d || (stamp[y] != queryStamp && treeReach(y, d))) return true;
+                if (stamp[y] != queryStamp && mayReach(y, d)) {
+                    stamp[y] = queryStamp;
+                    stack.push_back(y);
                 }
             }
         }
-
-        path.pop_back();
         return false;
     }
 
-    // Метод для вызова DFS
-    bool dfsWrapper(int start, int end) {
-        vector<bool> visited(numVertices, false);
-        vector<int> path;
-        return dfs(start, end, visited, path);
+    int getNumComponents() const {
+        return numComponents;
     }
 
-    // Методы для получения представлений графа
-    vector<vector<int>> getAdjMatrix() {
-        return adjMatrix;
+    bool usesBitsets() const {
+        return !closure.empty();
     }
 
-    vector<vector<int>> getAdjList() {
-        return adjList;
+    // Объём памяти индекса в байтах
+    size_t memoryBytes() const {
+        size_t bytes = (comp.size() + dagOffsets.size() + dagTargets.size() + stamp.size() + pre.size()) * sizeof(int);
+        for (int k = 0; k < numIntervals; ++k) bytes += (low[k].size() + post[k].size()) * sizeof(int);
+        return bytes + closure.size() * sizeof(uint64_t);
     }
+};
 
-    vector<pair<int, int>> getEdges() {
-        return edges;
+// Счётчик промахов кэша процессора через perf_event_open (только Linux; если счётчики
+// недоступны, например в контейнере, available() возвращает false)
+class CacheMissCounter {
+private:
+    int fd = -1;
+
+public:
+    CacheMissCounter() {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
     }
 
-    // Метод для отображения графа
-    void displayGraph() {
-        cout << "Adjacency Matrix: \n";
-        for (auto& row : adjMatrix) {
-            for (int val : row) {
-                cout << val << " ";
-            }
-            cout << endl;
-        }
+    ~CacheMissCounter() {
+        if (fd >= 0) close(fd);
+    }
 
-        cout << "Adjacency List: \n";
-        for (int i = 0; i < adjList.size(); ++i) {
-            cout << i << ": ";
-            for (int v : adjList[i]) {
-                cout << v << " ";
-            }
-            cout << endl;
-        }
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
 
-        cout << "Edges: \n";
-        for (auto& edge : edges) {
-            cout << edge.first << " -> " << edge.second << endl;
-        }
+    bool available() const { return fd >= 0; }
+
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    long long stop() {
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
     }
 };
 
@@ -211,7 +2074,586 @@ void testGraphs(int minVertices, int maxVertices, int minEdges, int maxEdges,
     }
 }
 
-int main() {
+// Сравнение обычного BFS и BFS с оптимизацией направления на графах разной плотности
+void benchmarkDirectionOptimizing(int numVertices, bool directed) {
+    vector<int> averageDegrees = {2, 8, 32, 128};
+    int numQueries = 20;
+
+    cout << "\nDirection-optimizing BFS benchmark, " << numVertices << " vertices\n";
+    cout << "AvgDegree|Edges|BFS(ns)|DO-BFS(ns)|Speedup\n";
+
+    for (int degree : averageDegrees) {
+        // G(n, p) со средней степенью degree
+        GraphGenerator generator(numVertices, directed, 0, degree, thread::hardware_concurrency());
+        vector<pair<int, int>> edgeList = generator.erdosRenyiGnp((double)degree / (numVertices - 1));
+        long long edges = edgeList.size();
+        RandomGraph graph(numVertices, edgeList, directed);
+        graph.setVerbose(false);
+
+        long long bfsTime = 0, doTime = 0;
+        for (int q = 0; q < numQueries; ++q) {
+            // Первый запрос — путь из вершины в саму себя
+            int start = rand() % numVertices;
+            int end = q == 0 ? start : rand() % numVertices;
+
+            auto start_time = high_resolution_clock::now();
+            bool foundBfs = graph.bfs(start, end);
+            auto end_time = high_resolution_clock::now();
+            bfsTime += duration_cast<nanoseconds>(end_time - start_time).count();
+            int bfsLength = foundBfs ? graph.getLastPathLength() : -1;
+
+            start_time = high_resolution_clock::now();
+            bool foundDo = graph.bfsDirectionOptimizing(start, end);
+            end_time = high_resolution_clock::now();
+            doTime += duration_cast<nanoseconds>(end_time - start_time).count();
+            int doLength = foundDo ? graph.getLastPathLength() : -1;
+
+            if (foundBfs != foundDo || bfsLength != doLength) {
+                cout << "Mismatch between BFS and DO-BFS for " << start << " -> " << end << endl;
+            }
+        }
+
+        cout << degree << "|" << edges << "|" << bfsTime / numQueries << "|" << doTime / numQueries
+             << "|" << (double)bfsTime / max(doTime, 1LL) << "\n";
+    }
+}
+
+// Масштабирование многопоточного BFS по числу потоков на большом случайном графе
+void benchmarkParallelBfs(int numVertices, int averageDegree, bool directed) {
+    long long edgesCount = directed ? (long long)numVertices * averageDegree : (long long)numVertices * averageDegree / 2;
+    GraphGenerator generator(numVertices, directed, 0, 42, thread::hardware_concurrency());
+    RandomGraph graph(numVertices, generator.erdosRenyiGnm(edgesCount), directed);
+    graph.setVerbose(false);
+
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    int numQueries = 5;
+    vector<pair<int, int>> queries;
+    for (int q = 0; q < numQueries; ++q) {
+        // Первый запрос — путь из вершины в саму себя
+        int start = rand() % numVertices;
+        queries.push_back({start, q == 0 ? start : rand() % numVertices});
+    }
+
+    cout << "\nParallel BFS scaling, " << numVertices << " vertices, " << edgesCount << " edges\n";
+
+    // Длины путей последовательного BFS (-1 — пути нет) для сверки с многопоточным
+    vector<int> expectedLength;
+    long long sequentialTime = 0;
+    for (auto& q : queries) {
+        auto start_time = high_resolution_clock::now();
+        bool found = graph.bfs(q.first, q.second);
+        auto end_time = high_resolution_clock::now();
+        sequentialTime += duration_cast<nanoseconds>(end_time - start_time).count();
+        expectedLength.push_back(found ? graph.getLastPathLength() : -1);
+    }
+    cout << "Sequential BFS: " << sequentialTime / numQueries << " ns\n";
+    cout << "Threads|TIME(ns)|Speedup|Mismatches\n";
+
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        long long parallelTime = 0;
+        int mismatches = 0;
+        for (int q = 0; q < numQueries; ++q) {
+            auto start_time = high_resolution_clock::now();
+            bool found = graph.bfsParallel(queries[q].first, queries[q].second, threads);
+            auto end_time = high_resolution_clock::now();
+            parallelTime += duration_cast<nanoseconds>(end_time - start_time).count();
+            if ((found ? graph.getLastPathLength() : -1) != expectedLength[q]) ++mismatches;
+        }
+        cout << threads << "|" << parallelTime / numQueries << "|" << (double)sequentialTime / max(parallelTime, 1LL)
+             << "|" << mismatches << "\n";
+    }
+}
+
+// Сравнение bfs() и двунаправленного BFS на случайных парах вершин: число посещённых вершин и время
+void benchmarkBidirectionalBfs(int numVertices, int averageDegree, bool directed) {
+    long long edgesCount = directed ? (long long)numVertices * averageDegree : (long long)numVertices * averageDegree / 2;
+    GraphGenerator generator(numVertices, directed, 0, 7, thread::hardware_concurrency());
+    RandomGraph graph(numVertices, generator.erdosRenyiGnm(edgesCount), directed);
+    graph.setVerbose(false);
+
+    int numQueries = 200;
+    long long bfsTime = 0, biTime = 0, bfsVisited = 0, biVisited = 0;
+    int mismatches = 0;
+
+    for (int q = 0; q < numQueries; ++q) {
+        // Первый запрос — путь из вершины в саму себя
+        int start = rand() % numVertices;
+        int end = q == 0 ? start : rand() % numVertices;
+
+        auto start_time = high_resolution_clock::now();
+        bool foundBfs = graph.bfs(start, end);
+        auto end_time = high_resolution_clock::now();
+        bfsTime += duration_cast<nanoseconds>(end_time - start_time).count();
+        bfsVisited += graph.getLastVisitedCount();
+        int bfsLength = foundBfs ? graph.getLastPathLength() : -1;
+
+        start_time = high_resolution_clock::now();
+        bool foundBi = graph.bfsBidirectional(start, end);
+        end_time = high_resolution_clock::now();
+        biTime += duration_cast<nanoseconds>(end_time - start_time).count();
+        biVisited += graph.getLastVisitedCount();
+        int biLength = foundBi ? graph.getLastPathLength() : -1;
+
+        if (bfsLength != biLength) ++mismatches;
+    }
+
+    cout << "\nBidirectional BFS benchmark, " << numVertices << " vertices, " << edgesCount
+         << (directed ? " directed" : " undirected") << " edges, " << numQueries << " queries\n";
+    cout << "Method|Avg visited|Avg TIME(ns)\n";
+    cout << "BFS|" << bfsVisited / numQueries << "|" << bfsTime / numQueries << "\n";
+    cout << "Bidirectional|" << biVisited / numQueries << "|" << biTime / numQueries << "\n";
+    cout << "Path length mismatches: " << mismatches << "\n";
+}
+
+// Пакет запросов расстояний: bfs() для каждой пары против MS-BFS по 64 и по 256 источников
+void benchmarkMultiSourceBfs(int numVertices, int averageDegree, int numSources, int numTargets) {
+    GraphGenerator generator(numVertices, false, 0, 11, thread::hardware_concurrency());
+    RandomGraph graph(numVertices, generator.erdosRenyiGnm((long long)numVertices * averageDegree / 2), false);
+    graph.setVerbose(false);
+
+    vector<int> sources(numSources), targets(numTargets);
+    for (int& s : sources) s = rand() % numVertices;
+    for (int& t : targets) t = rand() % numVertices;
+
+    auto start_time = high_resolution_clock::now();
+    vector<vector<int>> expected(numSources, vector<int>(numTargets, -1));
+    for (int i = 0; i < numSources; ++i) {
+        for (int j = 0; j < numTargets; ++j) {
+            if (sources[i] == targets[j]) {
+                expected[i][j] = 0;
+            } else if (graph.bfs(sources[i], targets[j])) {
+                expected[i][j] = graph.getLastPathLength();
+            }
+        }
+    }
+    auto end_time = high_resolution_clock::now();
+    long long loopTime = duration_cast<microseconds>(end_time - start_time).count();
+
+    start_time = high_resolution_clock::now();
+    vector<vector<int>> dist64 = graph.multiSourceDistances<1>(sources, targets);
+    end_time = high_resolution_clock::now();
+    long long time64 = duration_cast<microseconds>(end_time - start_time).count();
+
+    start_time = high_resolution_clock::now();
+    vector<vector<int>> dist256 = graph.multiSourceDistances<4>(sources, targets);
+    end_time = high_resolution_clock::now();
+    long long time256 = duration_cast<microseconds>(end_time - start_time).count();
+
+    cout << "\nMulti-source BFS, " << numVertices << " vertices, " << numSources << " x " << numTargets << " queries\n";
+    cout << "Method|TIME(us)|Per query(ns)|Matches bfs()\n";
+    long long queries = (long long)numSources * numTargets;
+    cout << "bfs() loop|" << loopTime << "|" << loopTime * 1000 / queries << "|yes\n";
+    cout << "MS-BFS 64|" << time64 << "|" << time64 * 1000 / queries << "|" << (dist64 == expected ? "yes" : "no") << "\n";
+    cout << "MS-BFS 256|" << time256 << "|" << time256 * 1000 / queries << "|" << (dist256 == expected ? "yes" : "no") << "\n";
+}
+
+// Кратчайшие пути во взвешенном графе: Дейкстра с разными очередями и delta-stepping
+void benchmarkShortestPaths(int numVertices, int averageDegree, int maxWeight) {
+    GraphGenerator generator(numVertices, false, 0, 5, thread::hardware_concurrency());
+    RandomGraph graph(numVertices, generator.erdosRenyiGnm((long long)numVertices * averageDegree / 2), false);
+    graph.assignRandomWeights(maxWeight, 5);
+    int source = rand() % numVertices;
+
+    cout << "\nWeighted shortest paths, " << numVertices << " vertices, average degree " << averageDegree
+         << ", weights 1.." << maxWeight << "\n";
+    cout << "Method|Relaxations|TIME(ms)|Matches Dijkstra\n";
+
+    auto start_time = high_resolution_clock::now();
+    vector<long long> expected = graph.dijkstra<LazyBinaryHeap>(source);
+    auto end_time = high_resolution_clock::now();
+    cout << "Dijkstra (binary heap)|" << graph.getLastRelaxations() << "|"
+         << duration_cast<milliseconds>(end_time - start_time).count() << "|yes\n";
+
+    start_time = high_resolution_clock::now();
+    vector<long long> dist = graph.dijkstra<IndexedDaryHeap<4>>(source);
+    end_time = high_resolution_clock::now();
+    cout << "Dijkstra (4-ary heap)|" << graph.getLastRelaxations() << "|"
+         << duration_cast<milliseconds>(end_time - start_time).count() << "|" << (dist == expected ? "yes" : "no") << "\n";
+
+    start_time = high_resolution_clock::now();
+    dist = graph.dijkstra<BucketQueue>(source, maxWeight);
+    end_time = high_resolution_clock::now();
+    cout << "Dijkstra (buckets)|" << graph.getLastRelaxations() << "|"
+         << duration_cast<milliseconds>(end_time - start_time).count() << "|" << (dist == expected ? "yes" : "no") << "\n";
+
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    for (int delta : {maxWeight / 10 + 1, maxWeight / averageDegree + 1, maxWeight}) {
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            start_time = high_resolution_clock::now();
+            dist = graph.deltaStepping(source, delta, threads);
+            end_time = high_resolution_clock::now();
+            cout << "Delta-stepping (delta " << delta << ", " << threads << " threads)|" << graph.getLastRelaxations() << "|"
+                 << duration_cast<milliseconds>(end_time - start_time).count() << "|" << (dist == expected ? "yes" : "no") << "\n";
+        }
+    }
+}
+
+// Время и промахи кэша BFS/DFS до и после перенумерации вершин. Запросы задаются в исходных
+// номерах и переводятся в текущие, поэтому все варианты отвечают на одни и те же вопросы
+void benchmarkReordering(int scale, int averageDegree) {
+    int numVertices = 1 << scale;
+    GraphGenerator generator(numVertices, false, 0, 3, thread::hardware_concurrency());
+    vector<pair<int, int>> edgeList = generator.rmat((long long)numVertices * averageDegree / 2);
+    double actualDegree = 2.0 * edgeList.size() / numVertices;
+    RandomGraph base(numVertices, edgeList, false);
+    base.setVerbose(false);
+
+    vector<pair<int, int>> queries;
+    for (int q = 0; q < 20; ++q) {
+        queries.push_back({rand() % numVertices, rand() % numVertices});
+    }
+
+    CacheMissCounter counter;
+    cout << "\nVertex reordering, R-MAT graph with " << numVertices << " vertices, " << edgeList.size()
+         << " edges, average degree " << actualDegree << "\n";
+    if (!counter.available()) cout << "(hardware cache-miss counters are not available)\n";
+    cout << "Order|Reorder(ms)|BFS(ms)|BFS misses|DFS(ms)|DFS misses|BFS speedup|DFS speedup\n";
+
+    const char* names[] = {"Original", "Degree", "RCM", "BFS"};
+    double baseBfs = 0, baseDfs = 0;
+
+    for (int variant = 0; variant < 4; ++variant) {
+        RandomGraph graph = base;
+
+        auto start_time = high_resolution_clock::now();
+        if (variant == 1) graph.reorder(VertexOrder::Degree);
+        if (variant == 2) graph.reorder(VertexOrder::ReverseCuthillMcKee);
+        if (variant == 3) graph.reorder(VertexOrder::Bfs);
+        auto end_time = high_resolution_clock::now();
+        long long reorderTime = duration_cast<milliseconds>(end_time - start_time).count();
+
+        double times[2];
+        long long misses[2];
+        for (int method = 0; method < 2; ++method) {
+            counter.start();
+            start_time = high_resolution_clock::now();
+            for (auto& q : queries) {
+                int start = graph.getInternalId(q.first), end = graph.getInternalId(q.second);
+                if (method == 0) graph.bfs(start, end);
+                else graph.dfsWrapper(start, end);
+            }
+            end_time = high_resolution_clock::now();
+            misses[method] = counter.stop();
+            times[method] = duration_cast<microseconds>(end_time - start_time).count() / 1000.0;
+        }
+
+        if (variant == 0) {
+            baseBfs = times[0];
+            baseDfs = times[1];
+        }
+        cout << names[variant] << "|" << reorderTime << "|" << times[0] << "|" << misses[0] << "|" << times[1] << "|"
+             << misses[1] << "|" << baseBfs / times[0] << "|" << baseDfs / times[1] << "\n";
+    }
+}
+
+// Запросы достижимости: индекс против bfs() на ориентированных графах разной плотности
+void benchmarkReachability(int numVertices, double averageDegree) {
+    GraphGenerator generator(numVertices, true, 0, 9, thread::hardware_concurrency());
+    RandomGraph graph(numVertices, generator.erdosRenyiGnm((long long)(numVertices * averageDegree)), true);
+    graph.setVerbose(false);
+
+    auto start_time = high_resolution_clock::now();
+    ReachabilityIndex index(graph);
+    auto end_time = high_resolution_clock::now();
+
+    cout << "\nReachability index, " << numVertices << " vertices, average out-degree " << averageDegree << "\n";
+    cout << "Components: " << index.getNumComponents() << ", labels: " << (index.usesBitsets() ? "bitsets" : "intervals")
+         << ", build: " << duration_cast<milliseconds>(end_time - start_time).count() << " ms, memory: "
+         << index.memoryBytes() / 1024 << " KB\n";
+
+    int bfsQueries = 50, indexQueries = 1000000;
+    vector<pair<int, int>> queries(indexQueries);
+    for (auto& q : queries) {
+        q = {rand() % numVertices, rand() % numVertices};
+        if (q.first == q.second) q.second = (q.second + 1) % numVertices;
+    }
+
+    int mismatches = 0;
+    start_time = high_resolution_clock::now();
+    for (int i = 0; i < bfsQueries; ++i) {
+        if (graph.bfs(queries[i].first, queries[i].second) != index.reachable(queries[i].first, queries[i].second)) {
+            ++mismatches;
+        }
+    }
+    end_time = high_resolution_clock::now();
+    long long bfsTime = duration_cast<nanoseconds>(end_time - start_time).count() / bfsQueries;
+
+    long long positive = 0;
+    start_time = high_resolution_clock::now();
+    for (auto& q : queries) {
+        positive += index.reachable(q.first, q.second);
+    }
+    end_time = high_resolution_clock::now();
+    long long indexTime = duration_cast<nanoseconds>(end_time - start_time).count() / indexQueries;
+
+    cout << "bfs() per query: " << bfsTime << " ns, index per query: " << indexTime << " ns, reachable: "
+         << positive * 100 / indexQueries << "%, mismatches with bfs(): " << mismatches << "\n";
+}
+
+// Поток изменений графа вперемешку с запросами: на каждый запрос bfs() приходится
+// updatesPerQuery вставок и удалений случайных рёбер
+void benchmarkDynamicGraph(int numVertices, int averageDegree, bool directed, int updatesPerQuery) {
+    long long edgesCount = directed ? (long long)numVertices * averageDegree : (long long)numVertices * averageDegree / 2;
+    GraphGenerator generator(numVertices, directed, 0, 13, thread::hardware_concurrency());
+    RandomGraph graph(numVertices, generator.erdosRenyiGnm(edgesCount), directed);
+    graph.setVerbose(false);
+    graph.enableDynamic();
+
+    mt19937 rng(13);
+    int numQueries = 200;
+    long long updates = 0, updateTime = 0, queryTime = 0, connectedTime = 0;
+    int mismatches = 0;
+
+    for (int q = 0; q < numQueries; ++q) {
+        auto start_time = high_resolution_clock::now();
+        for (int i = 0; i < updatesPerQuery; ++i) {
+            if (rng() % 2 == 0) {
+                graph.addEdge(rng() % numVertices, rng() % numVertices);
+            } else {
+                const vector<pair<int, int>>& edges = graph.edgeList();
+                pair<int, int> edge = edges[rng() % edges.size()];
+                graph.removeEdge(edge.first, edge.second);
+            }
+            ++updates;
+        }
+        auto end_time = high_resolution_clock::now();
+        updateTime += duration_cast<nanoseconds>(end_time - start_time).count();
+
+        int start = rng() % numVertices, end = rng() % numVertices;
+        if (start == end) end = (end + 1) % numVertices;
+
+        start_time = high_resolution_clock::now();
+        bool connected = graph.connected(start, end);
+        end_time = high_resolution_clock::now();
+        connectedTime += duration_cast<nanoseconds>(end_time - start_time).count();
+
+        start_time = high_resolution_clock::now();
+        bool found = graph.bfs(start, end);
+        end_time = high_resolution_clock::now();
+        queryTime += duration_cast<nanoseconds>(end_time - start_time).count();
+
+        // Для ориентированного графа компоненты слабой связности: путь возможен только внутри компоненты
+        if (directed ? (found && !connected) : (found != connected)) ++mismatches;
+    }
+
+    cout << "\nDynamic graph, " << numVertices << " vertices, " << (directed ? "directed" : "undirected") << ", "
+         << updatesPerQuery << " updates per query\n";
+    cout << "Updates/s: " << (long long)(updates * 1e9 / max(updateTime, 1LL)) << ", ns per update: " << updateTime / updates
+         << ", bfs(): " << queryTime / numQueries << " ns, connected(): " << connectedTime / numQueries << " ns\n";
+    cout << "Edges: " << graph.getNumEdges() << ", components: " << graph.getNumComponents()
+         << ", mismatches with bfs(): " << mismatches << "\n";
+}
+
+// DFS на графе-цепочке: рекурсивная версия переполняла стек вызовов уже на 10^5 вершинах
+void benchmarkDeepDfs(int numVertices) {
+    vector<pair<int, int>> chain;
+    chain.reserve(numVertices - 1);
+    for (int v = 0; v + 1 < numVertices; ++v) {
+        chain.push_back({v, v + 1});
+    }
+    RandomGraph graph(numVertices, chain, false);
+    graph.setVerbose(false);
+
+    auto start_time = high_resolution_clock::now();
+    bool found = graph.dfsWrapper(0, numVertices - 1);
+    auto end_time = high_resolution_clock::now();
+
+    cout << "\nDFS on a chain of " << numVertices << " vertices: "
+         << (found ? "path length " + to_string(graph.getLastPathLength()) : string("no path"))
+         << ", TIME: " << duration_cast<nanoseconds>(end_time - start_time).count() << " ns\n";
+}
+
+// Время генераторов графов и их воспроизводимость при разном числе потоков
+void benchmarkGenerators(int numVertices, int averageDegree, int maxEdgesPerVertex) {
+    long long m = (long long)numVertices * averageDegree / 2;
+    double p = (double)averageDegree / (numVertices - 1);
+    int maxThreads = max(1u, thread::hardware_concurrency());
+
+    cout << "\nGraph generators, " << numVertices << " vertices, average degree " << averageDegree
+         << ", maxEdgesPerVertex " << maxEdgesPerVertex << "\n";
+    cout << "Generator|Threads|Edges|Max degree|Checksum|TIME(ms)\n";
+
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        GraphGenerator generator(numVertices, false, maxEdgesPerVertex, 2024, threads);
+
+        for (int kind = 0; kind < 3; ++kind) {
+            auto start_time = high_resolution_clock::now();
+            vector<pair<int, int>> edgeList = kind == 0 ? generator.erdosRenyiGnp(p)
+                                            : kind == 1 ? generator.erdosRenyiGnm(m)
+                                                        : generator.rmat(m);
+            auto end_time = high_resolution_clock::now();
+
+            vector<int> degree(numVertices, 0);
+            unsigned long long checksum = 0;
+            for (auto& edge : edgeList) {
+                ++degree[edge.first];
+                ++degree[edge.second];
+                checksum = checksum * 1000003 + edge.first * 31 + edge.second;
+            }
+
+            const char* names[] = {"G(n,p)", "G(n,m)", "R-MAT"};
+            cout << names[kind] << "|" << threads << "|" << edgeList.size() << "|"
+                 << *max_element(degree.begin(), degree.end()) << "|" << checksum << "|"
+                 << duration_cast<milliseconds>(end_time - start_time).count() << "\n";
+        }
+    }
+}
+
+// Поиск в графе из файла прямо по массивам CSR отображения, без копирования в RandomGraph:
+// память графа — только страницы файла, а загрузка — только mmap и проверка заголовка и смещений.
+// Кратчайший по числу рёбер путь start -> end (пусто, если пути нет; при start == end — одна вершина)
+vector<int> mappedBfs(const MappedGraph& file, int start, int end) {
+    vector<int> parent(file.getNumVertices(), -1);
+    vector<bool> visited(file.getNumVertices(), false);
+    vector<int> q = {start};
+    visited[start] = true;
+
+    for (size_t head = 0; head < q.size() && !visited[end]; ++head) {
+        int u = q[head];
+        for (const int32_t* v = file.neighborsBegin(u); v != file.neighborsEnd(u); ++v) {
+            if (!visited[*v]) {
+                visited[*v] = true;
+                parent[*v] = u;
+                q.push_back(*v);
+            }
+        }
+    }
+
+    vector<int> path;
+    if (!visited[end]) return path;
+    for (int v = end; v != -1; v = parent[v]) {
+        path.push_back(v);
+    }
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+// Путь start -> end поиском в глубину с явным стеком кадров (вершина, следующий сосед), как в RandomGraph::dfs
+vector<int> mappedDfs(const MappedGraph& file, int start, int end) {
+    vector<bool> visited(file.getNumVertices(), false);
+    vector<pair<int, const int32_t*>> stack = {{start, file.neighborsBegin(start)}};
+    visited[start] = true;
+
+    while (!stack.empty() && stack.back().first != end) {
+        int vertex = stack.back().first;
+        const int32_t*& next = stack.back().second;
+        while (next != file.neighborsEnd(vertex) && visited[*next]) {
+            ++next;
+        }
+
+        if (next == file.neighborsEnd(vertex)) {
+            stack.pop_back();
+        } else {
+            int neighbor = *next++;
+            visited[neighbor] = true;
+            stack.push_back({neighbor, file.neighborsBegin(neighbor)});
+        }
+    }
+
+    vector<int> path;
+    for (auto& frame : stack) {
+        path.push_back(frame.first);
+    }
+    return path;
+}
+
+// Расстояния Дейкстры от source по весам из файла (1 для невзвешенного графа), -1 для недостижимых
+vector<long long> mappedDijkstra(const MappedGraph& file, int source) {
+    vector<long long> dist(file.getNumVertices(), LLONG_MAX);
+    IndexedDaryHeap<4> queue(file.getNumVertices());
+
+    dist[source] = 0;
+    queue.push(source, 0);
+    while (!queue.empty()) {
+        auto top = queue.pop();
+        int u = top.first;
+        if (top.second > dist[u]) continue;
+
+        const int32_t* weight = file.weightsBegin(u);
+        for (const int32_t* v = file.neighborsBegin(u); v != file.neighborsEnd(u); ++v) {
+            long long candidate = dist[u] + (weight ? *weight++ : 1);
+            if (candidate < dist[*v]) {
+                dist[*v] = candidate;
+                queue.push(*v, candidate);
+            }
+        }
+    }
+
+    for (auto& d : dist) {
+        if (d == LLONG_MAX) d = -1;
+    }
+    return dist;
+}
+
+// Поиск путей между случайными парами вершин в графе, загруженном из двоичного файла.
+// Все запросы идут по отображённым массивам CSR, время загрузки — это время mmap и проверки файла
+void testLoadedGraph(const string& path, int numQueries) {
+    auto start_time = high_resolution_clock::now();
+    MappedGraph file(path);
+    auto end_time = high_resolution_clock::now();
+
+    cout << "Mapped " << path << ": " << file.getNumVertices() << " vertices, " << file.getNumArcs()
+         << " arcs in " << duration_cast<milliseconds>(end_time - start_time).count() << " ms\n";
+    if (file.getNumVertices() == 0) return;
+    bool verbose = file.getNumVertices() <= 100;
+
+    auto report = [&](const char* label, const vector<int>& found) {
+        if (found.empty()) {
+            cout << "No path found using " << label << ".";
+        } else {
+            if (verbose) {
+                cout << "Path (" << label << "): ";
+                for (int v : found) cout << v << " ";
+                cout << "\n";
+            }
+            cout << label << " path length " << found.size() - 1;
+        }
+        cout << ", " << label << " Time: " << duration_cast<nanoseconds>(end_time - start_time).count() << " ns\n";
+    };
+
+    for (int q = 0; q < numQueries; ++q) {
+        int start = rand() % file.getNumVertices();
+        int end = rand() % file.getNumVertices();
+        cout << "Searching for path from " << start << " to " << end << "...\n";
+
+        start_time = high_resolution_clock::now();
+        vector<int> found = mappedBfs(file, start, end);
+        end_time = high_resolution_clock::now();
+        report("BFS", found);
+
+        start_time = high_resolution_clock::now();
+        found = mappedDfs(file, start, end);
+        end_time = high_resolution_clock::now();
+        report("DFS", found);
+
+        start_time = high_resolution_clock::now();
+        long long distance = mappedDijkstra(file, start)[end];
+        end_time = high_resolution_clock::now();
+        cout << (distance >= 0 ? "Dijkstra distance " + to_string(distance) : string("Unreachable for Dijkstra"))
+             << ", Dijkstra Time: " << duration_cast<nanoseconds>(end_time - start_time).count() << " ns\n";
+    }
+}
+
+// Запуск без аргументов — генерация и тесты; с аргументами:
+//   l4 import <edges.txt> <graph.bin> [directed] — импорт текстового списка рёбер
+//   l4 <graph.bin>                              — поиск путей в готовом графе
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        try {
+            if (string(argv[1]) == "import" && argc >= 4) {
+                importEdgeList(argv[2], argv[3], argc >= 5 && string(argv[4]) == "directed");
+                cout << "Imported " << argv[2] << " into " << argv[3] << endl;
+            } else {
+                srand(time(0));
+                testLoadedGraph(argv[1], 10);
+            }
+        } catch (const exception& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+
     // Параметры генерации графов
     int minVertices = 5;
     int maxVertices = 15;
@@ -222,5 +2664,32 @@ int main() {
 
     testGraphs(minVertices, maxVertices, minEdges, maxEdges, maxEdgesPerVertex, directed);
 
+    benchmarkGenerators(1000000, 8, 0);
+    benchmarkGenerators(1000000, 8, 12);
+
+    benchmarkDirectionOptimizing(100000, false);
+    benchmarkDirectionOptimizing(100000, true);
+
+    benchmarkParallelBfs(1000000, 8, false);
+
+    benchmarkBidirectionalBfs(100000, 4, false);
+    benchmarkBidirectionalBfs(100000, 4, true);
+
+    benchmarkDeepDfs(1000000);
+
+    benchmarkMultiSourceBfs(20000, 8, 256, 16);
+
+    benchmarkShortestPaths(1000000, 8, 100);
+
+    benchmarkReordering(20, 8);
+
+    benchmarkReachability(1000000, 1.0);
+    benchmarkReachability(1000000, 1.5);
+    benchmarkReachability(1000000, 4.0);
+
+    benchmarkDynamicGraph(100000, 4, false, 100);
+    benchmarkDynamicGraph(100000, 4, false, 10000);
+    benchmarkDynamicGraph(100000, 4, true, 10000);
+
     return 0;
 }
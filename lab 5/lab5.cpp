@@ -5,59 +5,226 @@
 #include <climits>
 #include <chrono>
 #include <fstream>
-#include <queue>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <memory>
+#include <immintrin.h>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace std;
 
 // Массив с возможными значениями связей для каждой вершины
 vector<int> possibleConnections = {3, 4, 10, 20};
 
-// Функция для проверки связности графа с использованием BFS
-bool isConnected(const vector<vector<int>>& graph, int N) {
-    vector<bool> visited(N, false);
-    queue<int> q;
-    q.push(0);
-    visited[0] = true;
+// Генератор для больших графов: rand() может не покрывать 10^6 вершин (RAND_MAX бывает 32767)
+mt19937 rng;
 
-    while (!q.empty()) {
-        int u = q.front();
-        q.pop();
+// Граница, до которой строится матрица смежности и запускается плотный алгоритм Прима
+const int maxDenseVertices = 5000;
 
-        for (int v = 0; v < N; ++v) {
-            if (graph[u][v] != 0 && !visited[v]) {
-                visited[v] = true;
-                q.push(v);
-            }
+// Ребро списка смежности
+struct Edge {
+    int to;
+    int weight;
+};
+
+// Двоичный формат графа из lab 4, версия 1 (little-endian):
+//   GraphFileHeader
+//   uint64 offsets[numVertices + 1] — начало списка соседей каждой вершины (CSR)
+//   int32  targets[numArcs]         — соседи; неориентированное ребро хранится в обе стороны
+//   int32  weights[numArcs]         — веса рёбер, только если в flags есть graphFileWeighted
+struct GraphFileHeader {
+    char magic[4];          // "GRPH"
+    uint32_t version;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t numVertices;
+    uint64_t numArcs;
+};
+
+const uint32_t graphFileVersion = 1;
+const uint32_t graphFileDirected = 1;
+const uint32_t graphFileWeighted = 2;
+
+// Граф из двоичного файла, отображённого в память через mmap; массивы CSR используются на месте
+class MappedGraph {
+private:
+    void* data = MAP_FAILED;
+    size_t size = 0;
+    const GraphFileHeader* header = nullptr;
+    const uint64_t* offsets = nullptr;
+    const int32_t* targets = nullptr;
+    const int32_t* weights = nullptr;
+
+public:
+    explicit MappedGraph(const string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("Cannot open graph file " + path);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GraphFileHeader)) {
+            close(fd);
+            throw runtime_error("Graph file is too short: " + path);
+        }
+        size = st.st_size;
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) throw runtime_error("Cannot mmap graph file " + path);
+
+        header = static_cast<const GraphFileHeader*>(data);
+        uint64_t n = header->numVertices, arcs = header->numArcs;
+        // Поля заголовка ограничиваются размером файла до вычисления ожидаемого размера:
+        // иначе подобранные numVertices или numArcs переполнят сумму и она совпадёт с настоящей
+        if (n > (size - sizeof(GraphFileHeader)) / sizeof(uint64_t) || arcs > size / sizeof(int32_t)) {
+            munmap(data, size);
+            throw runtime_error("Not a version 1 graph file: " + path);
+        }
+        uint64_t expected = sizeof(GraphFileHeader) + (n + 1) * sizeof(uint64_t) + arcs * sizeof(int32_t);
+        if (header->flags & graphFileWeighted) expected += arcs * sizeof(int32_t);
+
+        if (memcmp(header->magic, "GRPH", 4) != 0 || header->version != graphFileVersion
+            || n > INT_MAX || size != expected) {
+            munmap(data, size);
+            throw runtime_error("Not a version 1 graph file: " + path);
+        }
+
+        offsets = reinterpret_cast<const uint64_t*>(header + 1);
+        targets = reinterpret_cast<const int32_t*>(offsets + n + 1);
+        if (header->flags & graphFileWeighted) weights = targets + arcs;
+
+        // Один проход по offsets и targets: смещения не убывают, а концы дуг — номера вершин,
+        // иначе neighborsBegin/neighborsEnd и обход соседей выйдут за пределы отображения
+        bool valid = offsets[0] == 0 && offsets[n] == arcs;
+        for (uint64_t v = 0; valid && v < n; ++v) {
+            valid = offsets[v] <= offsets[v + 1];
+        }
+        for (uint64_t i = 0; valid && i < arcs; ++i) {
+            valid = targets[i] >= 0 && (uint64_t)targets[i] < n;
+        }
+        if (!valid) {
+            munmap(data, size);
+            throw runtime_error("Corrupted offsets or targets in graph file " + path);
         }
     }
 
-    // Если все вершины были посещены, то граф связан
-    for (bool v : visited) {
-        if (!v) return false;
+    ~MappedGraph() {
+        if (data != MAP_FAILED) munmap(data, size);
     }
 
-    return true;
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    int getNumVertices() const { return header->numVertices; }
+    long long getNumArcs() const { return header->numArcs; }
+    bool isDirected() const { return header->flags & graphFileDirected; }
+    bool isWeighted() const { return weights != nullptr; }
+
+    // Соседи вершины v: [neighborsBegin(v), neighborsEnd(v)), веса лежат по тем же индексам
+    const int32_t* neighborsBegin(int v) const { return targets + offsets[v]; }
+    const int32_t* neighborsEnd(int v) const { return targets + offsets[v + 1]; }
+    const int32_t* weightsBegin(int v) const { return weights ? weights + offsets[v] : nullptr; }
+};
+
+// Список смежности по графу из файла; у невзвешенного графа вес каждого ребра равен 1.
+// Для MST граф должен быть неориентированным. Копия сделана сознательно: все реализации MST
+// (mstEngines) работают со списками смежности, а после копирования отображение можно сразу
+// закрыть, так что граф не держится в памяти дважды во время замеров
+vector<vector<Edge>> adjacencyFromFile(const MappedGraph& file, const string& path) {
+    if (file.isDirected()) throw runtime_error("MST needs an undirected graph: " + path);
+
+    int N = file.getNumVertices();
+    vector<vector<Edge>> adj(N);
+    for (int u = 0; u < N; ++u) {
+        const int32_t* weight = file.weightsBegin(u);
+        adj[u].reserve(file.neighborsEnd(u) - file.neighborsBegin(u));
+        for (const int32_t* v = file.neighborsBegin(u); v != file.neighborsEnd(u); ++v) {
+            adj[u].push_back({*v, weight ? *weight++ : 1});
+        }
+    }
+    return adj;
 }
 
-// Функция для добавления ребер, чтобы граф стал связным
-void ensureConnectedGraph(vector<vector<int>>& graph, int N) {
-    // Если граф не связан, добавляем дополнительные ребра
-    if (!isConnected(graph, N)) {
-        for (int i = 0; i < N; ++i) {
-            for (int j = i + 1; j < N; ++j) {
-                if (graph[i][j] == 0) {
-                    int weight = rand() % 20 + 1;  // случайный вес ребра от 1 до 20
-                    graph[i][j] = weight;
-                    graph[j][i] = weight;
-                }
-            }
+// Система непересекающихся множеств: объединение по размеру и сжатие путей
+class DisjointSets {
+private:
+    vector<int> parent;
+    vector<int> size;
+
+public:
+    explicit DisjointSets(int n) : parent(n), size(n, 1) {
+        for (int i = 0; i < n; ++i) parent[i] = i;
+    }
+
+    int find(int x) {
+        int root = x;
+        while (parent[root] != root) root = parent[root];
+        while (parent[x] != root) {
+            int next = parent[x];
+            parent[x] = root;
+            x = next;
         }
+        return root;
+    }
+
+    // Корень без сжатия путей: безопасно вызывать из нескольких потоков, пока никто не объединяет
+    int findReadOnly(int x) const {
+        while (parent[x] != x) x = parent[x];
+        return x;
+    }
+
+    // Объединение множеств; false, если a и b уже в одном множестве
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (size[a] < size[b]) swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+};
+
+// Функция для добавления ребер, чтобы граф стал связным: sets хранит компоненты, собранные
+// при генерации, и каждая следующая компонента связывается с предыдущей одним ребром между
+// случайными вершинами — всего (число компонент - 1) рёбер вместо заполнения всей матрицы
+void ensureConnectedGraph(vector<vector<int>>& graph, int N, DisjointSets& sets) {
+    // Случайный представитель каждой компоненты (выборка с резервуаром)
+    vector<int> seen(N, 0), representative(N, -1);
+    for (int v = 0; v < N; ++v) {
+        int root = sets.find(v);
+        if (rand() % ++seen[root] == 0) representative[root] = v;
+    }
+
+    int previous = -1;
+    for (int root = 0; root < N; ++root) {
+        if (representative[root] == -1) continue;
+        if (previous != -1) {
+            int u = representative[root];
+            int weight = rand() % 20 + 1;  // случайный вес ребра от 1 до 20
+            graph[u][previous] = weight;
+            graph[previous][u] = weight;
+        }
+        previous = representative[root];
     }
 }
 
 // Функция для создания графа с N вершинами
 vector<vector<int>> generateGraph(int N) {
     vector<vector<int>> graph(N, vector<int>(N, 0));
+    DisjointSets sets(N);  // Компоненты связности по мере добавления рёбер
 
     // Сначала создаем случайные ребра для связности
     for (int i = 0; i < N; ++i) {
@@ -77,16 +244,628 @@ vector<vector<int>> generateGraph(int N) {
                 int weight = rand() % 20 + 1;  // случайный вес ребра от 1 до 20
                 graph[i][randVertex] = weight;
                 graph[randVertex][i] = weight;  // граф неориентированный
+                sets.unite(i, randVertex);
             }
         }
     }
 
     // Теперь проверим, является ли граф связным, и если нет, добавим ребра для связности
-    ensureConnectedGraph(graph, N);
+    ensureConnectedGraph(graph, N, sets);
 
     return graph;
 }
 
+// Проверка связности разреженного графа обходом в ширину
+bool isConnected(const vector<vector<Edge>>& adj) {
+    int N = adj.size();
+    if (N == 0) return true;
+    vector<bool> visited(N, false);
+    vector<int> q = {0};
+    visited[0] = true;
+    for (size_t head = 0; head < q.size(); ++head) {
+        for (const Edge& e : adj[q[head]]) {
+            if (!visited[e.to]) {
+                visited[e.to] = true;
+                q.push_back(e.to);
+            }
+        }
+    }
+    return (int)q.size() == N;
+}
+
+// Соединение компонент разреженного графа: компоненты помечаются обходом в ширину,
+// а каждая следующая связывается с предыдущей одним ребром случайного веса
+void connectComponents(vector<vector<Edge>>& adj) {
+    int N = adj.size();
+    vector<int> component(N, -1);
+    int previous = -1;
+    for (int root = 0; root < N; ++root) {
+        if (component[root] != -1) continue;
+        component[root] = root;
+        vector<int> q = {root};
+        for (size_t head = 0; head < q.size(); ++head) {
+            for (const Edge& e : adj[q[head]]) {
+                if (component[e.to] == -1) {
+                    component[e.to] = root;
+                    q.push_back(e.to);
+                }
+            }
+        }
+
+        if (previous != -1) {
+            int u = q[rng() % q.size()];
+            int weight = rng() % 20 + 1;
+            adj[u].push_back({previous, weight});
+            adj[previous].push_back({u, weight});
+        }
+        previous = root;
+    }
+}
+
+// Разреженный граф с N вершинами по тем же правилам, что и generateGraph, но без матрицы N x N
+vector<vector<Edge>> generateSparseGraph(int N) {
+    vector<vector<Edge>> adj(N);
+    vector<int> connectedTo(N, -1);  // connectedTo[v] == i — вершина v уже связана с i
+
+    for (int i = 0; i < N; ++i) {
+        int numConnections = possibleConnections[rng() % possibleConnections.size()];
+        if (numConnections >= N - 1) numConnections = N - 1;
+
+        for (int j = 0; j < numConnections; ++j) {
+            int randVertex = rng() % N;
+            if (randVertex != i && connectedTo[randVertex] != i) {
+                connectedTo[randVertex] = i;
+                int weight = rng() % 20 + 1;  // случайный вес ребра от 1 до 20
+                adj[i].push_back({randVertex, weight});
+                adj[randVertex].push_back({i, weight});
+            }
+        }
+    }
+
+    connectComponents(adj);
+    return adj;
+}
+
+// Список смежности по матрице смежности
+vector<vector<Edge>> toAdjacencyList(const vector<vector<int>>& graph) {
+    int N = graph.size();
+    vector<vector<Edge>> adj(N);
+    for (int u = 0; u < N; ++u) {
+        for (int v = 0; v < N; ++v) {
+            if (graph[u][v] != 0) adj[u].push_back({v, graph[u][v]});
+        }
+    }
+    return adj;
+}
+
+// Индексированная D-арная куча вершин по ключу с уменьшением ключа: position[v] — место вершины в куче
+template <int D>
+class IndexedDaryHeap {
+private:
+    vector<int> heap;
+    vector<int> key;
+    vector<int> position;
+
+    void siftUp(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (key[heap[parent]] <= key[v]) break;
+            heap[i] = heap[parent];
+            position[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = v;
+        position[v] = i;
+    }
+
+    void siftDown(int i) {
+        int v = heap[i];
+        int size = heap.size();
+        while (true) {
+            int first = D * i + 1;
+            if (first >= size) break;
+            int best = first;
+            for (int c = first + 1; c < min(first + D, size); ++c) {
+                if (key[heap[c]] < key[heap[best]]) best = c;
+            }
+            if (key[heap[best]] >= key[v]) break;
+            heap[i] = heap[best];
+            position[heap[i]] = i;
+            i = best;
+        }
+        heap[i] = v;
+        position[v] = i;
+    }
+
+public:
+    explicit IndexedDaryHeap(int n) : key(n), position(n, -1) {}
+
+    // Добавление вершины или уменьшение её ключа
+    void push(int v, int k) {
+        key[v] = k;
+        if (position[v] == -1) {
+            heap.push_back(v);
+            siftUp(heap.size() - 1);
+        } else {
+            siftUp(position[v]);
+        }
+    }
+
+    int pop() {
+        int v = heap[0];
+        position[v] = -1;
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) siftDown(0);
+        return v;
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+};
+
+// Алгоритм Прима для разреженного графа: список смежности и 4-арная куча с уменьшением ключа,
+// O(E log V) вместо O(V^2) у плотной версии
+long long primSparse(const vector<vector<Edge>>& adj) {
+    int N = adj.size();
+    vector<bool> inMST(N, false);
+    vector<int> key(N, INT_MAX);
+    IndexedDaryHeap<4> heap(N);
+    long long totalWeight = 0;
+
+    key[0] = 0;
+    heap.push(0, 0);
+    while (!heap.empty()) {
+        int u = heap.pop();
+        inMST[u] = true;
+        totalWeight += key[u];
+
+        for (const Edge& e : adj[u]) {
+            if (!inMST[e.to] && e.weight < key[e.to]) {
+                key[e.to] = e.weight;
+                heap.push(e.to, e.weight);
+            }
+        }
+    }
+
+    return totalWeight;
+}
+
+// Ребро графа для Краскала и Борувки
+struct WeightedEdge {
+    int u;
+    int v;
+    int weight;
+};
+
+// Каждое неориентированное ребро списка смежности один раз (u < v)
+vector<WeightedEdge> collectEdges(const vector<vector<Edge>>& adj) {
+    vector<WeightedEdge> edges;
+    for (int u = 0; u < (int)adj.size(); ++u) {
+        for (const Edge& e : adj[u]) {
+            if (u < e.to) edges.push_back({u, e.to, e.weight});
+        }
+    }
+    return edges;
+}
+
+// Алгоритм Краскала: рёбра по возрастанию веса, циклы отсекаются системой непересекающихся множеств
+long long kruskalAlgorithm(const vector<vector<Edge>>& adj) {
+    int N = adj.size();
+    vector<WeightedEdge> edges = collectEdges(adj);
+    sort(edges.begin(), edges.end(), [](const WeightedEdge& a, const WeightedEdge& b) { return a.weight < b.weight; });
+
+    DisjointSets sets(N);
+    long long totalWeight = 0;
+    int taken = 0;
+    for (const WeightedEdge& e : edges) {
+        if (sets.unite(e.u, e.v)) {
+            totalWeight += e.weight;
+            if (++taken == N - 1) break;
+        }
+    }
+    return totalWeight;
+}
+
+// Параллельный цикл по [0, count): потоки по очереди забирают порции по chunkSize элементов
+// и вызывают body(номер потока, начало, конец)
+template <typename Func>
+void parallelChunks(size_t count, int numThreads, size_t chunkSize, Func body) {
+    atomic<size_t> nextChunk(0);
+    auto worker = [&](int id) {
+        while (true) {
+            size_t begin = nextChunk.fetch_add(chunkSize, memory_order_relaxed);
+            if (begin >= count) break;
+            body(id, begin, min(begin + chunkSize, count));
+        }
+    };
+
+    vector<thread> threads;
+    for (int id = 1; id < numThreads; ++id) {
+        threads.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+// Многопоточный алгоритм Борувки. В каждом раунде потоки параллельно выбирают для каждой
+// компоненты самое лёгкое выходящее ребро (атомарный минимум по ключу «вес, номер ребра» —
+// одинаковые веса различаются номером, поэтому циклов не возникает), затем выбранные рёбра
+// объединяют компоненты, вершины получают новые метки, а рёбра внутри компонент выбрасываются.
+// Число компонент каждый раз уменьшается хотя бы вдвое
+long long boruvkaAlgorithm(const vector<vector<Edge>>& adj, int numThreads) {
+    int N = adj.size();
+    vector<WeightedEdge> edges = collectEdges(adj);
+    vector<int> component(N);
+    for (int v = 0; v < N; ++v) component[v] = v;
+
+    DisjointSets sets(N);
+    vector<atomic<uint64_t>> best(N);
+    const size_t chunkSize = 4096;
+    long long totalWeight = 0;
+
+    while (!edges.empty()) {
+        parallelChunks(N, numThreads, chunkSize, [&](int, size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) best[v].store(UINT64_MAX, memory_order_relaxed);
+        });
+
+        parallelChunks(edges.size(), numThreads, chunkSize, [&](int, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                // Инверсия знакового бита переводит int в беззнаковый с тем же порядком:
+                // отрицательные веса не расширяются знаком и не затирают номер ребра
+                uint64_t key = (uint64_t)(uint32_t)(edges[i].weight ^ INT_MIN) << 32 | i;
+                for (int c : {component[edges[i].u], component[edges[i].v]}) {
+                    uint64_t current = best[c].load(memory_order_relaxed);
+                    while (key < current && !best[c].compare_exchange_weak(current, key, memory_order_relaxed)) {
+                    }
+                }
+            }
+        });
+
+        // Слияние компонент по выбранным рёбрам (их не больше числа компонент)
+        for (int c = 0; c < N; ++c) {
+            uint64_t key = best[c].load(memory_order_relaxed);
+            if (key == UINT64_MAX) continue;
+            const WeightedEdge& e = edges[key & 0xffffffffu];
+            if (sets.unite(e.u, e.v)) totalWeight += e.weight;
+        }
+
+        parallelChunks(N, numThreads, chunkSize, [&](int, size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) component[v] = sets.findReadOnly(v);
+        });
+
+        // Рёбра между разными компонентами сжимаются на месте внутри каждой порции,
+        // затем порции сдвигаются подряд — без второй копии списка рёбер
+        vector<size_t> keptInChunk((edges.size() + chunkSize - 1) / chunkSize);
+        parallelChunks(edges.size(), numThreads, chunkSize, [&](int, size_t begin, size_t end) {
+            size_t out = begin;
+            for (size_t i = begin; i < end; ++i) {
+                if (component[edges[i].u] != component[edges[i].v]) edges[out++] = edges[i];
+            }
+            keptInChunk[begin / chunkSize] = out - begin;
+        });
+        size_t total = 0;
+        for (size_t chunk = 0; chunk < keptInChunk.size(); ++chunk) {
+            size_t begin = chunk * chunkSize;
+            if (total != begin) move(edges.begin() + begin, edges.begin() + begin + keptInChunk[chunk], edges.begin() + total);
+            total += keptInChunk[chunk];
+        }
+        edges.resize(total);
+    }
+
+    return totalWeight;
+}
+
+// Алгоритмы MST, работающие со списком смежности; все запускаются в серии тестов
+struct MstEngine {
+    const char* name;
+    long long (*run)(const vector<vector<Edge>>& adj);
+};
+
+vector<MstEngine> mstEngines = {
+    {"Prim (heap)", primSparse},
+    {"Kruskal", kruskalAlgorithm},
+    {"Boruvka", [](const vector<vector<Edge>>& adj) {
+         return boruvkaAlgorithm(adj, max(1u, thread::hardware_concurrency()));
+     }},
+};
+
+// Динамическое минимальное остовное дерево: рёбра можно добавлять и менять им вес, не
+// пересчитывая MST заново. Остовный лес хранится в link-cut дереве, где каждое ребро дерева —
+// отдельный узел со своим весом, поэтому самое тяжёлое ребро пути между u и v находится
+// за амортизированное O(log N):
+//   - новое ребро или подешевевшее ребро вне дерева заменяет самое тяжёлое ребро цикла, если легче его;
+//   - подешевевшее ребро дерева просто меняет вес;
+//   - подорожавшее ребро дерева вырезается, и среди рёбер, пересекающих разрез, выбирается самое
+//     лёгкое. Меньшая из двух частей находится встречным обходом обеих, так что работа
+//     пропорциональна размеру меньшей части и степеням её вершин
+class DynamicMst {
+private:
+    struct DynamicEdge {
+        int u;
+        int v;
+        int weight;
+        bool inTree;
+    };
+
+    int numVertices;
+    vector<DynamicEdge> edges;
+    vector<vector<int>> incident;  // Номера рёбер, инцидентных вершине
+    long long totalWeight = 0;
+
+    // Link-cut дерево: узлы 0..N-1 — вершины, N + i — ребро i
+    vector<int> left, right, parent;
+    vector<char> flip;
+    vector<int> value;    // Вес ребра; у вершин INT_MIN
+    vector<int> heaviest; // Узел с наибольшим весом в поддереве splay-дерева
+
+    // Метки встречного обхода при вырезании ребра
+    vector<int> visitStamp;
+    vector<char> visitSide;
+    int stamp = 0;
+
+    vector<int> splayPath;  // Буфер для проталкивания отложенных разворотов в splay
+
+    bool isSplayRoot(int x) const {
+        int p = parent[x];
+        return p == -1 || (left[p] != x && right[p] != x);
+    }
+
+    void pull(int x) {
+        heaviest[x] = x;
+        if (left[x] != -1 && value[heaviest[left[x]]] > value[heaviest[x]]) heaviest[x] = heaviest[left[x]];
+        if (right[x] != -1 && value[heaviest[right[x]]] > value[heaviest[x]]) heaviest[x] = heaviest[right[x]];
+    }
+
+    void push(int x) {
+        if (!flip[x]) return;
+        swap(left[x], right[x]);
+        if (left[x] != -1) flip[left[x]] ^= 1;
+        if (right[x] != -1) flip[right[x]] ^= 1;
+        flip[x] = 0;
+    }
+
+    void rotate(int x) {
+        int p = parent[x], g = parent[p];
+        bool pIsRoot = isSplayRoot(p);
+        if (left[p] == x) {
+            left[p] = right[x];
+            if (right[x] != -1) parent[right[x]] = p;
+            right[x] = p;
+        } else {
+            right[p] = left[x];
+            if (left[x] != -1) parent[left[x]] = p;
+            left[x] = p;
+        }
+        parent[p] = x;
+        parent[x] = g;
+        if (!pIsRoot) {
+            if (left[g] == p) left[g] = x;
+            else right[g] = x;
+        }
+        pull(p);
+        pull(x);
+    }
+
+    void splay(int x) {
+        vector<int>& path = splayPath;
+        path.clear();
+        for (int y = x;; y = parent[y]) {
+            path.push_back(y);
+            if (isSplayRoot(y)) break;
+        }
+        for (int i = path.size() - 1; i >= 0; --i) push(path[i]);
+
+        while (!isSplayRoot(x)) {
+            int p = parent[x];
+            if (!isSplayRoot(p)) {
+                int g = parent[p];
+                rotate((left[g] == p) == (left[p] == x) ? p : x);
+            }
+            rotate(x);
+        }
+    }
+
+    void access(int x) {
+        for (int last = -1, y = x; y != -1; last = y, y = parent[y]) {
+            splay(y);
+            right[y] = last;
+            pull(y);
+        }
+        splay(x);
+    }
+
+    void makeRoot(int x) {
+        access(x);
+        flip[x] ^= 1;
+    }
+
+    int findRoot(int x) {
+        access(x);
+        while (true) {
+            push(x);
+            if (left[x] == -1) break;
+            x = left[x];
+        }
+        splay(x);
+        return x;
+    }
+
+    void link(int x, int y) {
+        makeRoot(x);
+        parent[x] = y;
+    }
+
+    // Разрыв ребра дерева link-cut между соседними узлами x и y
+    void cut(int x, int y) {
+        makeRoot(x);
+        access(y);
+        parent[left[y]] = -1;
+        left[y] = -1;
+        pull(y);
+    }
+
+    void attach(int id) {
+        int node = numVertices + id;
+        value[node] = edges[id].weight;
+        heaviest[node] = node;
+        link(edges[id].u, node);
+        link(node, edges[id].v);
+        edges[id].inTree = true;
+        totalWeight += edges[id].weight;
+    }
+
+    void detach(int id) {
+        int node = numVertices + id;
+        cut(edges[id].u, node);
+        cut(node, edges[id].v);
+        edges[id].inTree = false;
+        totalWeight -= edges[id].weight;
+    }
+
+    void addNode() {
+        left.push_back(-1);
+        right.push_back(-1);
+        parent.push_back(-1);
+        flip.push_back(0);
+        value.push_back(INT_MIN);
+        heaviest.push_back(left.size() - 1);
+    }
+
+    // Ребро id вне дерева: войти в дерево, если оно легче самого тяжёлого ребра на пути между концами
+    void tryImprove(int id) {
+        int u = edges[id].u, v = edges[id].v;
+        if (u == v) return;
+        if (findRoot(u) != findRoot(v)) {
+            attach(id);
+            return;
+        }
+        makeRoot(u);
+        access(v);
+        int node = heaviest[v];
+        if (value[node] > edges[id].weight) {
+            detach(node - numVertices);
+            attach(id);
+        }
+    }
+
+    // Ребро дерева id подорожало: вырезать его и соединить части самым лёгким пересекающим ребром
+    void replaceTreeEdge(int id) {
+        detach(id);
+
+        // Встречный обход частей по рёбрам дерева до исчерпания одной из них
+        ++stamp;
+        int start[2] = {edges[id].u, edges[id].v};
+        vector<int> queue[2] = {{start[0]}, {start[1]}};
+        size_t head[2] = {0, 0};
+        for (int side = 0; side < 2; ++side) {
+            visitStamp[start[side]] = stamp;
+            visitSide[start[side]] = side;
+        }
+        int smaller = -1;
+        while (smaller == -1) {
+            for (int side = 0; side < 2 && smaller == -1; ++side) {
+                if (head[side] == queue[side].size()) {
+                    smaller = side;
+                    break;
+                }
+                int x = queue[side][head[side]++];
+                for (int e : incident[x]) {
+                    if (!edges[e].inTree) continue;
+                    int y = edges[e].u == x ? edges[e].v : edges[e].u;
+                    if (visitStamp[y] != stamp) {
+                        visitStamp[y] = stamp;
+                        visitSide[y] = side;
+                        queue[side].push_back(y);
+                    }
+                }
+            }
+        }
+
+        // Самое лёгкое ребро из меньшей части наружу (само ребро id тоже кандидат)
+        int best = id;
+        for (int x : queue[smaller]) {
+            for (int e : incident[x]) {
+                if (edges[e].inTree || edges[e].weight >= edges[best].weight) continue;
+                int y = edges[e].u == x ? edges[e].v : edges[e].u;
+                if (visitStamp[y] != stamp || visitSide[y] != smaller) best = e;
+            }
+        }
+        attach(best);
+    }
+
+public:
+    explicit DynamicMst(const vector<vector<Edge>>& adj)
+        : numVertices(adj.size()), incident(adj.size()), visitStamp(adj.size(), 0), visitSide(adj.size(), 0) {
+        for (int v = 0; v < numVertices; ++v) addNode();
+
+        vector<WeightedEdge> initial = collectEdges(adj);
+        sort(initial.begin(), initial.end(), [](const WeightedEdge& a, const WeightedEdge& b) { return a.weight < b.weight; });
+        DisjointSets sets(numVertices);
+        for (const WeightedEdge& e : initial) {
+            int id = addEdgeRecord(e.u, e.v, e.weight);
+            if (sets.unite(e.u, e.v)) attach(id);
+        }
+    }
+
+    // Добавление ребра без обновления дерева; возвращает номер ребра
+    int addEdgeRecord(int u, int v, int weight) {
+        int id = edges.size();
+        edges.push_back({u, v, weight, false});
+        incident[u].push_back(id);
+        if (v != u) incident[v].push_back(id);
+        addNode();
+        return id;
+    }
+
+    // Новое ребро (u, v); возвращает его номер для последующих setWeight
+    int addEdge(int u, int v, int weight) {
+        int id = addEdgeRecord(u, v, weight);
+        tryImprove(id);
+        return id;
+    }
+
+    void setWeight(int id, int weight) {
+        DynamicEdge& e = edges[id];
+        int oldWeight = e.weight;
+        if (weight == oldWeight) return;
+
+        if (!e.inTree) {
+            e.weight = weight;
+            if (weight < oldWeight) tryImprove(id);
+        } else if (weight < oldWeight) {
+            int node = numVertices + id;
+            access(node);
+            value[node] = weight;
+            pull(node);
+            e.weight = weight;
+            totalWeight += weight - oldWeight;
+        } else {
+            totalWeight += weight - oldWeight;
+            e.weight = weight;
+            replaceTreeEdge(id);
+        }
+    }
+
+    long long getTotalWeight() const { return totalWeight; }
+    int getNumEdges() const { return edges.size(); }
+    int getWeight(int id) const { return edges[id].weight; }
+
+    // Текущий граф списком смежности (для проверки пересчётом)
+    vector<vector<Edge>> currentGraph() const {
+        vector<vector<Edge>> adj(numVertices);
+        for (const DynamicEdge& e : edges) {
+            adj[e.u].push_back({e.v, e.weight});
+            if (e.u != e.v) adj[e.v].push_back({e.u, e.weight});
+        }
+        return adj;
+    }
+};
+
 // Алгоритм Прима для поиска минимального остовного дерева
 int primAlgorithm(const vector<vector<int>>& graph) {
     int N = graph.size();
@@ -118,6 +897,323 @@ int primAlgorithm(const vector<vector<int>>& graph) {
     return totalWeight;
 }
 
+// Буфер int, выровненный по 32 байтам для загрузок AVX2
+struct AlignedFree {
+    void operator()(int* p) const { free(p); }
+};
+using AlignedInts = unique_ptr<int[], AlignedFree>;
+
+AlignedInts allocateAligned(size_t count) {
+    int* p = static_cast<int*>(aligned_alloc(32, (count * sizeof(int) + 31) / 32 * 32));
+    if (!p) throw bad_alloc();
+    return AlignedInts(p);
+}
+
+// Матрица смежности одним выровненным буфером по строкам. Длина строки дополнена до кратной 8,
+// отсутствие ребра хранится как INT_MAX, поэтому обновление ключей в Приме — это просто min
+class DenseMatrix {
+private:
+    int numVertices;
+    int stride;
+    AlignedInts data;
+
+public:
+    explicit DenseMatrix(const vector<vector<int>>& graph)
+        : numVertices(graph.size()), stride((graph.size() + 7) / 8 * 8),
+          data(allocateAligned((size_t)numVertices * stride)) {
+        for (int u = 0; u < numVertices; ++u) {
+            int* out = data.get() + (size_t)u * stride;
+            for (int v = 0; v < numVertices; ++v) {
+                out[v] = graph[u][v] != 0 ? graph[u][v] : INT_MAX;
+            }
+            for (int v = numVertices; v < stride; ++v) out[v] = INT_MAX;
+        }
+    }
+
+    int size() const { return numVertices; }
+    int getStride() const { return stride; }
+    const int* row(int u) const { return data.get() + (size_t)u * stride; }
+};
+
+// Одна итерация плотного Прима за проход по строке u: ключи вершин вне дерева уменьшаются
+// по весам рёбер из u, и сразу ищется следующая вершина с минимальным ключом.
+// inTree[v] == -1 для вершин дерева и дополнения строки, 0 для остальных; возвращает -1, если
+// достижимых вершин не осталось
+int primStepScalar(const int* row, int* key, const int* inTree, int stride) {
+    int best = INT_MAX, bestIndex = -1;
+    for (int v = 0; v < stride; ++v) {
+        if (inTree[v]) continue;
+        if (row[v] < key[v]) key[v] = row[v];
+        if (key[v] < best) {
+            best = key[v];
+            bestIndex = v;
+        }
+    }
+    return bestIndex;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) int primStepAvx2(const int* row, int* key, const int* inTree, int stride) {
+    __m256i best = _mm256_set1_epi32(INT_MAX);
+    __m256i bestIndex = _mm256_set1_epi32(-1);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+
+    for (int v = 0; v < stride; v += 8) {
+        __m256i k = _mm256_load_si256((const __m256i*)(key + v));
+        __m256i r = _mm256_load_si256((const __m256i*)(row + v));
+        __m256i done = _mm256_load_si256((const __m256i*)(inTree + v));
+
+        // Вершины дерева сохраняют ключ, остальные берут минимум с весом ребра
+        k = _mm256_blendv_epi8(_mm256_min_epi32(k, r), k, done);
+        _mm256_store_si256((__m256i*)(key + v), k);
+
+        // Для поиска минимума ключ вершины дерева превращается в INT_MAX (ключи неотрицательны)
+        __m256i candidate = _mm256_or_si256(k, _mm256_srli_epi32(done, 1));
+        __m256i less = _mm256_cmpgt_epi32(best, candidate);
+        best = _mm256_min_epi32(best, candidate);
+        bestIndex = _mm256_blendv_epi8(bestIndex, index, less);
+        index = _mm256_add_epi32(index, step);
+    }
+
+    alignas(32) int values[8], indices[8];
+    _mm256_store_si256((__m256i*)values, best);
+    _mm256_store_si256((__m256i*)indices, bestIndex);
+    int result = -1, resultValue = INT_MAX;
+    for (int i = 0; i < 8; ++i) {
+        if (indices[i] != -1 && (values[i] < resultValue || (values[i] == resultValue && indices[i] < result))) {
+            resultValue = values[i];
+            result = indices[i];
+        }
+    }
+    return result;
+}
+#endif
+
+bool hasAvx2() {
+#if defined(__x86_64__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Алгоритм Прима по DenseMatrix: обновление ключей и выбор следующей вершины за один проход
+// по строке, с AVX2 при поддержке процессором и скалярным вариантом иначе
+long long primAlgorithmFlat(const DenseMatrix& matrix) {
+    int N = matrix.size(), stride = matrix.getStride();
+    if (N == 0) return 0;
+
+    AlignedInts key = allocateAligned(stride);
+    AlignedInts inTree = allocateAligned(stride);
+    for (int v = 0; v < stride; ++v) {
+        key[v] = INT_MAX;
+        inTree[v] = v < N ? 0 : -1;
+    }
+    key[0] = 0;
+
+    auto step = primStepScalar;
+#if defined(__x86_64__)
+    if (hasAvx2()) step = primStepAvx2;
+#endif
+
+    long long totalWeight = 0;
+    int u = 0;
+    for (int count = 0; count < N && u != -1; ++count) {
+        inTree[u] = -1;
+        totalWeight += key[u];
+        if (count + 1 < N) u = step(matrix.row(u), key.get(), inTree.get(), stride);
+    }
+    return totalWeight;
+}
+
+// k-d дерево над точками Dim-мерного пространства для евклидова MST. Точки переупорядочены так,
+// что каждый узел покрывает непрерывный отрезок [begin, end), и хранят ограничивающий параллелепипед
+template <int Dim>
+class KdTree {
+public:
+    using Point = array<double, Dim>;
+
+    struct Node {
+        Point low, high;
+        int begin, end;
+        int left = -1, right = -1;
+    };
+
+    static const int leafSize = 8;
+
+    vector<Point> points;
+    vector<Node> nodes;
+
+    explicit KdTree(const vector<Point>& input) : points(input) {
+        if (!points.empty()) build(0, points.size());
+    }
+
+    // Квадрат расстояния от точки до параллелепипеда узла
+    double boxDistance2(const Node& node, const Point& p) const {
+        double result = 0;
+        for (int d = 0; d < Dim; ++d) {
+            double gap = max(0.0, max(node.low[d] - p[d], p[d] - node.high[d]));
+            result += gap * gap;
+        }
+        return result;
+    }
+
+    static double distance2(const Point& a, const Point& b) {
+        double result = 0;
+        for (int d = 0; d < Dim; ++d) result += (a[d] - b[d]) * (a[d] - b[d]);
+        return result;
+    }
+
+private:
+    // Узлы нумеруются в прямом порядке: дети всегда имеют больший номер, чем родитель
+    int build(int begin, int end) {
+        int index = nodes.size();
+        nodes.push_back({});
+        Node node;
+        node.begin = begin;
+        node.end = end;
+        node.low = node.high = points[begin];
+        for (int i = begin + 1; i < end; ++i) {
+            for (int d = 0; d < Dim; ++d) {
+                node.low[d] = min(node.low[d], points[i][d]);
+                node.high[d] = max(node.high[d], points[i][d]);
+            }
+        }
+
+        if (end - begin > leafSize) {
+            int axis = 0;
+            for (int d = 1; d < Dim; ++d) {
+                if (node.high[d] - node.low[d] > node.high[axis] - node.low[axis]) axis = d;
+            }
+            int middle = begin + (end - begin) / 2;
+            nth_element(points.begin() + begin, points.begin() + middle, points.begin() + end,
+                        [axis](const Point& a, const Point& b) { return a[axis] < b[axis]; });
+            node.left = build(begin, middle);
+            node.right = build(middle, end);
+        }
+        nodes[index] = node;
+        return index;
+    }
+};
+
+// Евклидово минимальное остовное дерево (вес — сумма длин рёбер) алгоритмом Борувки над k-d деревом.
+// В каждом раунде для каждой точки ищется ближайшая точка из другой компоненты. Узлы, все точки
+// которых лежат в одной компоненте, помечены ею и при поиске из этой компоненты пропускаются,
+// а отсечение идёт по лучшему найденному расстоянию всей компоненты, а не отдельной точки.
+// Для точек в общем положении (все расстояния различны) MST единственно; совпадения расстояний
+// не приводят к циклам, так как лишние рёбра отбрасывает система непересекающихся множеств
+template <int Dim>
+double euclideanMst(const vector<array<double, Dim>>& input) {
+    using Point = typename KdTree<Dim>::Point;
+    KdTree<Dim> tree(input);
+    const vector<Point>& points = tree.points;
+    int N = points.size();
+
+    DisjointSets sets(N);
+    vector<int> component(N, 0), label(tree.nodes.size());
+    for (int i = 0; i < N; ++i) component[i] = i;
+    vector<double> bestDistance(N);
+    vector<pair<int, int>> bestEdge(N);
+    vector<int> stack;
+
+    double totalWeight = 0;
+    int numComponents = N;
+    while (numComponents > 1) {
+        // Метка узла — общая компонента его точек или -1
+        for (int n = tree.nodes.size() - 1; n >= 0; --n) {
+            const auto& node = tree.nodes[n];
+            if (node.left == -1) {
+                label[n] = component[node.begin];
+                for (int i = node.begin + 1; i < node.end && label[n] != -1; ++i) {
+                    if (component[i] != label[n]) label[n] = -1;
+                }
+            } else {
+                label[n] = label[node.left] == label[node.right] ? label[node.left] : -1;
+            }
+        }
+
+        fill(bestDistance.begin(), bestDistance.end(), numeric_limits<double>::infinity());
+        for (int i = 0; i < N; ++i) {
+            int c = component[i];
+            double& bound = bestDistance[c];
+            stack.assign(1, 0);
+            while (!stack.empty()) {
+                const auto& node = tree.nodes[stack.back()];
+                int n = stack.back();
+                stack.pop_back();
+                if (label[n] == c || tree.boxDistance2(node, points[i]) >= bound) continue;
+
+                if (node.left == -1) {
+                    for (int j = node.begin; j < node.end; ++j) {
+                        if (component[j] == c) continue;
+                        double d = KdTree<Dim>::distance2(points[i], points[j]);
+                        if (d < bound) {
+                            bound = d;
+                            bestEdge[c] = {i, j};
+                        }
+                    }
+                } else {
+                    // Ближний ребёнок кладётся последним, чтобы быть просмотренным первым
+                    double leftDistance = tree.boxDistance2(tree.nodes[node.left], points[i]);
+                    double rightDistance = tree.boxDistance2(tree.nodes[node.right], points[i]);
+                    if (leftDistance < rightDistance) {
+                        stack.push_back(node.right);
+                        stack.push_back(node.left);
+                    } else {
+                        stack.push_back(node.left);
+                        stack.push_back(node.right);
+                    }
+                }
+            }
+        }
+
+        for (int c = 0; c < N; ++c) {
+            if (bestDistance[c] == numeric_limits<double>::infinity()) continue;
+            if (sets.unite(bestEdge[c].first, bestEdge[c].second)) {
+                totalWeight += sqrt(bestDistance[c]);
+                --numComponents;
+            }
+        }
+        for (int i = 0; i < N; ++i) component[i] = sets.find(i);
+    }
+
+    return totalWeight;
+}
+
+// Эталонный евклидов MST: плотный алгоритм Прима по полному графу за O(N^2)
+template <int Dim>
+double euclideanMstPrim(const vector<array<double, Dim>>& points) {
+    int N = points.size();
+    vector<double> key(N, numeric_limits<double>::infinity());
+    vector<bool> inMST(N, false);
+    double totalWeight = 0;
+    if (N > 0) key[0] = 0;
+    for (int count = 0; count < N; ++count) {
+        int u = -1;
+        for (int i = 0; i < N; ++i) {
+            if (!inMST[i] && (u == -1 || key[i] < key[u])) u = i;
+        }
+        inMST[u] = true;
+        totalWeight += sqrt(key[u]);
+        for (int v = 0; v < N; ++v) {
+            if (!inMST[v]) key[v] = min(key[v], KdTree<Dim>::distance2(points[u], points[v]));
+        }
+    }
+    return totalWeight;
+}
+
+// N случайных точек, равномерно распределённых в единичном квадрате или кубе
+template <int Dim>
+vector<array<double, Dim>> generatePoints(int N) {
+    uniform_real_distribution<double> coordinate(0.0, 1.0);
+    vector<array<double, Dim>> points(N);
+    for (auto& p : points) {
+        for (int d = 0; d < Dim; ++d) p[d] = coordinate(rng);
+    }
+    return points;
+}
+
 // Функция для вывода матрицы смежности
 void printAdjacencyMatrix(const vector<vector<int>>& graph, int N) {
     cout << "Матрица смежности для графа с " << N << " вершинами:\n";
@@ -130,37 +1226,348 @@ void printAdjacencyMatrix(const vector<vector<int>>& graph, int N) {
     cout << "\n";
 }
 
-int main() {
+// Сравнение плотного Прима по vector<vector<int>> и по выровненной DenseMatrix
+// на плотных графах, в том числе больше maxDenseVertices
+void benchmarkDensePrim() {
+    cout << "Плотный Прим (" << (hasAvx2() ? "AVX2" : "скалярный") << ") против исходного:\n";
+    cout << "Vertices|TIME(ns)|Flat TIME(ns)|Speedup\n";
+    for (int N : {1000, 2000, 5000, 10000, 20000}) {
+        vector<vector<int>> graph = generateGraph(N);
+        DenseMatrix matrix(graph);
+
+        const int trials = 3;
+        long long bestOld = LLONG_MAX, bestFlat = LLONG_MAX;
+        for (int trial = 0; trial < trials; ++trial) {
+            auto start = chrono::high_resolution_clock::now();
+            int weight = primAlgorithm(graph);
+            auto middle = chrono::high_resolution_clock::now();
+            long long flatWeight = primAlgorithmFlat(matrix);
+            auto end = chrono::high_resolution_clock::now();
+
+            if (flatWeight != weight) {
+                cout << "Веса MST не совпадают для N = " << N << ": " << flatWeight << " вместо " << weight << "\n";
+            }
+            bestOld = min(bestOld, (long long)chrono::duration_cast<chrono::nanoseconds>(middle - start).count());
+            bestFlat = min(bestFlat, (long long)chrono::duration_cast<chrono::nanoseconds>(end - middle).count());
+        }
+        cout << N << "|" << bestOld << "|" << bestFlat << "|" << (double)bestOld / bestFlat << "\n";
+    }
+}
+
+// Пропускная способность DynamicMst на смеси добавлений рёбер, удешевлений и удорожаний
+// в сравнении с пересчётом MST алгоритмом Краскала после каждого изменения
+void benchmarkDynamicMst() {
+    const int N = 100000;
+    const int numUpdates = 300000;
+    vector<vector<Edge>> adj = generateSparseGraph(N);
+    DynamicMst mst(adj);
+
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < numUpdates; ++i) {
+        int kind = rng() % 3;
+        if (kind == 0) {
+            mst.addEdge(rng() % N, rng() % N, rng() % 20 + 1);
+        } else {
+            int id = rng() % mst.getNumEdges();
+            int weight = mst.getWeight(id);
+            mst.setWeight(id, kind == 1 ? rng() % weight + 1 : weight + rng() % 20 + 1);
+        }
+    }
+    auto end = chrono::high_resolution_clock::now();
+    double updateTime = (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count() / numUpdates;
+
+    vector<vector<Edge>> finalGraph = mst.currentGraph();
+    const int recomputeTrials = 3;
+    long long recomputedWeight = 0;
+    start = chrono::high_resolution_clock::now();
+    for (int trial = 0; trial < recomputeTrials; ++trial) recomputedWeight = kruskalAlgorithm(finalGraph);
+    end = chrono::high_resolution_clock::now();
+    double recomputeTime = (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count() / recomputeTrials;
+
+    cout << "Динамическое MST, N = " << N << ", " << numUpdates << " изменений: " << updateTime
+         << " нс на изменение, пересчёт Краскалом " << recomputeTime << " нс (в " << recomputeTime / updateTime
+         << " раз дольше)\n";
+    if (recomputedWeight != mst.getTotalWeight()) {
+        cout << "Веса MST не совпадают: динамическое " << mst.getTotalWeight() << ", пересчёт " << recomputedWeight << "\n";
+    }
+}
+
+// Параметры командной строки
+struct Options {
+    bool printMatrix = false;  // Выводить матрицы смежности графов до 100 вершин
+    bool suite = false;        // Запустить набор тестов на разреженных графах вместо обычной серии
+    int warmup = 1;            // Прогревочные запуски каждого алгоритма (в файл не пишутся)
+    int trials = 3;            // Замеряемые запуски каждого алгоритма
+    int maxVertices = 10000000;
+    string engineName;         // Пусто — все алгоритмы из mstEngines
+    string suiteOutput = "benchmark.txt";
+    vector<string> files;
+};
+
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        auto value = [&](const string& prefix) { return arg.substr(prefix.size()); };
+        if (arg == "--print-matrix") {
+            options.printMatrix = true;
+        } else if (arg == "--suite") {
+            options.suite = true;
+        } else if (arg.rfind("--warmup=", 0) == 0) {
+            options.warmup = stoi(value("--warmup="));
+        } else if (arg.rfind("--trials=", 0) == 0) {
+            options.trials = stoi(value("--trials="));
+        } else if (arg.rfind("--max-vertices=", 0) == 0) {
+            options.maxVertices = stoi(value("--max-vertices="));
+        } else if (arg.rfind("--engine=", 0) == 0) {
+            options.engineName = value("--engine=");
+        } else if (arg.rfind("--output=", 0) == 0) {
+            options.suiteOutput = value("--output=");
+        } else if (arg.rfind("--", 0) == 0) {
+            throw invalid_argument("неизвестный параметр " + arg);
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    return options;
+}
+
+// Значение поля вида "VmHWM:   1234 kB" из /proc/self/status в килобайтах, -1 если его нет
+long long readProcStatusKb(const char* field) {
+    ifstream status("/proc/self/status");
+    string line;
+    size_t length = strlen(field);
+    while (getline(status, line)) {
+        if (line.compare(0, length, field) == 0 && line.size() > length && line[length] == ':') {
+            return stoll(line.substr(length + 1));
+        }
+    }
+    return -1;
+}
+
+// Сброс пикового RSS процесса (VmHWM), чтобы замерять пик отдельного запуска. Без поддержки ядром
+// пик останется пиком за всё время работы
+void resetPeakMemory() {
+    ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+}
+
+// MST для графов из файлов в двоичном формате lab 4
+int runOnFiles(const Options& options) {
+    for (const string& path : options.files) {
+        try {
+            // Время mmap с проверкой файла и время копирования в списки смежности печатаются отдельно
+            vector<vector<Edge>> adj;
+            {
+                auto start = chrono::high_resolution_clock::now();
+                MappedGraph file(path);
+                auto mapped = chrono::high_resolution_clock::now();
+                adj = adjacencyFromFile(file, path);
+                auto end = chrono::high_resolution_clock::now();
+                cout << path << ": mmap " << chrono::duration_cast<chrono::nanoseconds>(mapped - start).count()
+                     << " нс, копирование в списки смежности "
+                     << chrono::duration_cast<chrono::nanoseconds>(end - mapped).count() << " нс\n";
+            }
+            if (adj.empty() || !isConnected(adj)) {
+                cout << path << ": граф несвязный, остовного дерева нет\n";
+                continue;
+            }
+
+            for (const MstEngine& engine : mstEngines) {
+                if (!options.engineName.empty() && options.engineName != engine.name) continue;
+
+                auto start = chrono::high_resolution_clock::now();
+                long long totalWeight = engine.run(adj);
+                auto end = chrono::high_resolution_clock::now();
+
+                cout << path << ": " << adj.size() << " вершин, " << engine.name << ", вес MST " << totalWeight
+                     << ", время " << chrono::duration_cast<chrono::nanoseconds>(end - start).count() << " нс\n";
+            }
+        } catch (const exception& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Набор тестов на разреженных графах от 10^3 до maxVertices вершин: каждый алгоритм запускается
+// warmup раз вхолостую и trials раз с замером. Каждый замер сразу дописывается в файл
+// (Vertices|Edges|Engine|TRY|TIME(ns)|BaseRSS(KB)|PeakRSS(KB)|Weight), так что прерванный запуск
+// оставляет всё, что успел измерить. BaseRSS — память процесса перед запуском (в основном сам граф),
+// PeakRSS — пик во время запуска
+int runBenchmarkSuite(const Options& options) {
+    ofstream outputFile(options.suiteOutput);
+    if (!outputFile) {
+        cerr << "Не удалось открыть " << options.suiteOutput << endl;
+        return 1;
+    }
+    outputFile << "Vertices|Edges|Engine|TRY|TIME(ns)|BaseRSS(KB)|PeakRSS(KB)|Weight" << endl;
+
+    for (long long N = 1000; N <= options.maxVertices; N *= 10) {
+        vector<vector<Edge>> adj = generateSparseGraph(N);
+        long long numEdges = 0;
+        for (const auto& list : adj) numEdges += list.size();
+        numEdges /= 2;
+        cout << "N = " << N << ", рёбер " << numEdges << endl;
+
+        long long referenceWeight = -1;
+        for (const MstEngine& engine : mstEngines) {
+            if (!options.engineName.empty() && options.engineName != engine.name) continue;
+
+            for (int run = 0; run < options.warmup; ++run) engine.run(adj);
+            for (int trial = 1; trial <= options.trials; ++trial) {
+                long long baseMemory = readProcStatusKb("VmRSS");
+                resetPeakMemory();
+                auto start = chrono::high_resolution_clock::now();
+                long long totalWeight = engine.run(adj);
+                auto end = chrono::high_resolution_clock::now();
+                long long peakMemory = readProcStatusKb("VmHWM");
+
+                if (referenceWeight == -1) referenceWeight = totalWeight;
+                if (totalWeight != referenceWeight) {
+                    cout << "Веса MST не совпадают для N = " << N << ": " << engine.name << " даёт " << totalWeight
+                         << " вместо " << referenceWeight << "\n";
+                }
+
+                outputFile << N << "|" << numEdges << "|" << engine.name << "|" << trial << "|"
+                           << chrono::duration_cast<chrono::nanoseconds>(end - start).count() << "|" << baseMemory
+                           << "|" << peakMemory << "|" << totalWeight << endl;
+            }
+        }
+    }
+
+    cout << "Результаты записаны в файл " << options.suiteOutput << ".\n";
+    return 0;
+}
+
+// Без аргументов — серия тестов на случайных графах (results.txt) и дополнительные сравнения.
+//   lab5 [--engine=<имя>] <graph.bin>...  — MST для графов из файлов в двоичном формате lab 4
+//                                           (например, полученных через "l4 import"); по умолчанию
+//                                           запускаются все алгоритмы из mstEngines
+//   lab5 --suite [--warmup=K] [--trials=K] [--max-vertices=N] [--engine=<имя>] [--output=<файл>]
+//                                         — набор тестов на разреженных графах до 10^7 вершин
+//   --print-matrix                        — выводить матрицы смежности в серии (по умолчанию выключено)
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    if (!options.files.empty()) return runOnFiles(options);
+
+    if (options.suite) {
+        rng.seed(time(0));
+        return runBenchmarkSuite(options);
+    }
+
     srand(time(0));  // Инициализация генератора случайных чисел
+    rng.seed(time(0));
 
-    vector<int> vertexCounts = {10, 20, 50, 100};  // Количество вершин
+    vector<int> vertexCounts = {10, 20, 50, 100, 1000, 10000, 100000, 1000000};  // Количество вершин
     ofstream outputFile("results.txt");  // Открытие файла для записи
 
-    // Заголовок для файла
-    outputFile << "Vertices|TRY|TIME(ns)|Weight\n";
+    // Заголовок для файла: строка на каждый алгоритм; плотный Прим запускается только до maxDenseVertices вершин,
+    // в конце — строки евклидова MST (Engine "Euclidean 2D/3D", N — число точек)
+    outputFile << "Vertices|TRY|Engine|TIME(ns)|Weight\n";
 
     // Тестируем для разных размеров графа
     for (int N : vertexCounts) {
         // Проводим серию из 5-10 тестов
         int numTests = 10;  // Вы можете увеличить до 10 для более точных результатов
+        long long generationTime = 0, edgeCount = 0;
         for (int test = 1; test <= numTests; ++test) {
-            // Создаем новый граф для каждого теста
-            vector<vector<int>> graph = generateGraph(N);
+            // Создаем новый граф для каждого теста: матрицу, пока она помещается в память, иначе сразу список
+            vector<vector<int>> graph;
+            vector<vector<Edge>> adj;
+            auto generationStart = chrono::high_resolution_clock::now();
+            if (N <= maxDenseVertices) {
+                graph = generateGraph(N);
+            } else {
+                adj = generateSparseGraph(N);
+            }
+            generationTime += chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() -
+                                                                         generationStart).count();
+            if (!graph.empty()) adj = toAdjacencyList(graph);
+            for (const auto& list : adj) edgeCount += list.size();
 
-            // Выводим матрицу смежности в консоль
-            printAdjacencyMatrix(graph, N);
+            // Выводим матрицу смежности в консоль, если это запрошено
+            if (options.printMatrix && N <= 100) printAdjacencyMatrix(graph, N);
 
-            // Запуск алгоритма Прима и замер времени
-            auto start = chrono::high_resolution_clock::now();
-            int totalWeight = primAlgorithm(graph);
-            auto end = chrono::high_resolution_clock::now();
+            long long referenceWeight = -1;
+            if (!graph.empty()) {
+                // Запуск алгоритма Прима и замер времени
+                auto start = chrono::high_resolution_clock::now();
+                int totalWeight = primAlgorithm(graph);
+                auto end = chrono::high_resolution_clock::now();
+
+                // Замер времени в наносекундах
+                auto nanoseconds = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+                outputFile << N << "|" << test << "|Prim (dense)|" << nanoseconds << "|" << totalWeight << "\n";
+                referenceWeight = totalWeight;
+
+                DenseMatrix matrix(graph);
+                start = chrono::high_resolution_clock::now();
+                long long flatWeight = primAlgorithmFlat(matrix);
+                end = chrono::high_resolution_clock::now();
+                nanoseconds = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+                if (flatWeight != referenceWeight) {
+                    cout << "Веса MST не совпадают для N = " << N << ": Prim (flat) даёт " << flatWeight << " вместо "
+                         << referenceWeight << "\n";
+                }
+                outputFile << N << "|" << test << "|Prim (flat)|" << nanoseconds << "|" << flatWeight << "\n";
+            }
+
+            for (const MstEngine& engine : mstEngines) {
+                auto start = chrono::high_resolution_clock::now();
+                long long totalWeight = engine.run(adj);
+                auto end = chrono::high_resolution_clock::now();
+                auto nanoseconds = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+
+                if (referenceWeight == -1) referenceWeight = totalWeight;
+                if (totalWeight != referenceWeight) {
+                    cout << "Веса MST не совпадают для N = " << N << ": " << engine.name << " даёт " << totalWeight
+                         << " вместо " << referenceWeight << "\n";
+                }
 
-            // Замер времени в наносекундах
-            chrono::duration<double> duration = end - start;
-            auto nanoseconds = chrono::duration_cast<chrono::nanoseconds>(duration).count();
+                // Записываем результаты в файл
+                outputFile << N << "|" << test << "|" << engine.name << "|" << nanoseconds << "|" << totalWeight << "\n";
+            }
+        }
+
+        cout << "N = " << N << ": генерация в среднем " << generationTime / numTests << " нс, рёбер в среднем "
+             << edgeCount / 2 / numTests << "\n";
+    }
+
+    // Евклидовы MST случайных точек в единичном квадрате и кубе, до 10^7 точек
+    for (int N : {1000, 10000, 100000, 1000000, 10000000}) {
+        int numTests = N >= 1000000 ? 1 : 10;
+        for (int test = 1; test <= numTests; ++test) {
+            for (int dim : {2, 3}) {
+                vector<array<double, 2>> points2;
+                vector<array<double, 3>> points3;
+                if (dim == 2) points2 = generatePoints<2>(N);
+                else points3 = generatePoints<3>(N);
 
-            // Записываем результаты в файл
-            outputFile << N << "|" << test << "|" << nanoseconds << "|" << totalWeight << "\n";
+                auto start = chrono::high_resolution_clock::now();
+                double totalWeight = dim == 2 ? euclideanMst<2>(points2) : euclideanMst<3>(points3);
+                auto end = chrono::high_resolution_clock::now();
+                auto nanoseconds = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+
+                if (N <= 1000) {
+                    double reference = dim == 2 ? euclideanMstPrim<2>(points2) : euclideanMstPrim<3>(points3);
+                    if (fabs(totalWeight - reference) > 1e-9 * reference) {
+                        cout << "Веса евклидова MST не совпадают для N = " << N << ": " << totalWeight << " вместо "
+                             << reference << "\n";
+                    }
+                }
+
+                outputFile << N << "|" << test << "|Euclidean " << dim << "D|" << nanoseconds << "|" << fixed
+                           << setprecision(6) << totalWeight << defaultfloat << "\n";
+            }
         }
     }
 
@@ -168,5 +1575,8 @@ int main() {
 
     cout << "Результаты записаны в файл results.txt.\n";
 
+    benchmarkDensePrim();
+    benchmarkDynamicMst();
+
     return 0;
 }
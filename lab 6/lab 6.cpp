@@ -5,6 +5,17 @@
 #include <chrono>
 #include <algorithm>
 #include <fstream>
+#include <string>
+#include <new>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <climits>
+#include <optional>
+#include <immintrin.h>
 
 using namespace std;
 using namespace chrono;
@@ -18,65 +29,187 @@ struct Node {
     Node(int value) : key(value), left(nullptr), right(nullptr), height(1) {}
 };
 
+// Пул узлов: узлы выделяются подряд из блоков по slabSize штук, освобождённые узлы
+// складываются в список свободных (связанный через left) и выдаются повторно.
+// clear() освобождает сразу целые блоки, не обходя дерево
+class NodeArena {
+public:
+    static const int slabSize = 4096;
+
+    NodeArena() : used(slabSize), freeList(nullptr) {}
+    ~NodeArena() { clear(); }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    Node* allocate(int key) {
+        if (freeList != nullptr) {
+            Node* node = freeList;
+            freeList = node->left;
+            return new (node) Node(key);
+        }
+        if (used == slabSize) {
+            slabs.push_back(static_cast<Node*>(::operator new(slabSize * sizeof(Node))));
+            used = 0;
+        }
+        return new (slabs.back() + used++) Node(key);
+    }
+
+    void release(Node* node) {
+        node->left = freeList;
+        freeList = node;
+    }
+
+    void clear() {
+        for (Node* slab : slabs) ::operator delete(slab);
+        slabs.clear();
+        used = slabSize;
+        freeList = nullptr;
+    }
+
+private:
+    vector<Node*> slabs;
+    int used;        // Занятых узлов в последнем блоке
+    Node* freeList;
+};
+
+// Порог, начиная с которого сортировка и построение дерева в buildFrom идут в несколько потоков
+const size_t parallelBuildThreshold = 1000000;
+
+// Сортировка по частям в отдельных потоках с последующим попарным слиянием соседних частей
+void parallelSort(vector<int>& data, int numThreads) {
+    size_t n = data.size();
+    if (numThreads < 2 || n < parallelBuildThreshold) {
+        sort(data.begin(), data.end());
+        return;
+    }
+
+    vector<size_t> bounds(numThreads + 1);
+    for (int t = 0; t <= numThreads; ++t) bounds[t] = n * t / numThreads;
+
+    vector<thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] { sort(data.begin() + bounds[t], data.begin() + bounds[t + 1]); });
+    }
+    for (auto& th : threads) th.join();
+
+    for (size_t width = 1; width < (size_t)numThreads; width *= 2) {
+        threads.clear();
+        for (size_t t = 0; t + width < (size_t)numThreads; t += 2 * width) {
+            size_t begin = bounds[t], middle = bounds[t + width], end = bounds[min(t + 2 * width, (size_t)numThreads)];
+            threads.emplace_back([&data, begin, middle, end] {
+                inplace_merge(data.begin() + begin, data.begin() + middle, data.begin() + end);
+            });
+        }
+        for (auto& th : threads) th.join();
+    }
+}
+
+// Пакетный поиск keys[0..count) в дереве с корнем root: out[i] = найден ли keys[i].
+// Ключи идут группами по groupSize поисков, которые спускаются по дереву вместе: за шаг каждый
+// активный поиск проходит один уровень и запрашивает упреждающую загрузку следующего узла,
+// так что промахи кэша разных поисков перекрываются, а не ждут друг друга
+const int maxSearchGroup = 64;
+
+void searchBatchInTree(const Node* root, const int* keys, bool* out, size_t count, int groupSize) {
+    groupSize = max(1, min(groupSize, maxSearchGroup));
+    const Node* cursor[maxSearchGroup];
+    size_t index[maxSearchGroup];
+
+    for (size_t first = 0; first < count; first += groupSize) {
+        int active = min((size_t)groupSize, count - first);
+        for (int g = 0; g < active; ++g) {
+            cursor[g] = root;
+            index[g] = first + g;
+        }
+
+        while (active > 0) {
+            for (int g = 0; g < active;) {
+                const Node* node = cursor[g];
+                int key = keys[index[g]];
+                if (node == nullptr || node->key == key) {
+                    out[index[g]] = node != nullptr;
+                    // Завершённый поиск заменяется последним активным
+                    --active;
+                    cursor[g] = cursor[active];
+                    index[g] = index[active];
+                    continue;
+                }
+                node = key < node->key ? node->left : node->right;
+                if (node != nullptr) __builtin_prefetch(node);
+                cursor[g++] = node;
+            }
+        }
+    }
+}
+
 class BinarySearchTree {
 public:
     Node* root;
 
-    BinarySearchTree() : root(nullptr) {}
+    // useArena == false — каждый узел через new/delete (для сравнения с пулом)
+    explicit BinarySearchTree(bool useArena = true) : root(nullptr), useArena(useArena) {}
+    ~BinarySearchTree() { clear(); }
 
-    void insert(int key) {
-        root = insertRec(root, key);
-    }
+    BinarySearchTree(const BinarySearchTree&) = delete;
+    BinarySearchTree& operator=(const BinarySearchTree&) = delete;
 
-    Node* insertRec(Node* node, int key) {
-        if (node == nullptr) return new Node(key);
+    Node* newNode(int key) {
+        return useArena ? arena.allocate(key) : new Node(key);
+    }
 
-        if (key < node->key)
-            node->left = insertRec(node->left, key);
-        else if (key > node->key)
-            node->right = insertRec(node->right, key);
+    void deleteNode(Node* node) {
+        if (useArena)
+            arena.release(node);
+        else
+            delete node;
+    }
 
-        return node;
+    // Все операции итеративные: на отсортированных данных дерево вырождается в список
+    // длины n, и рекурсия такой глубины переполнила бы стек
+    void insert(int key) {
+        Node** link = &root;
+        while (*link != nullptr) {
+            if (key == (*link)->key) return;
+            link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+        }
+        *link = newNode(key);
     }
 
     bool search(int key) {
-        return searchRec(root, key);
+        Node* node = root;
+        while (node != nullptr) {
+            if (key == node->key) return true;
+            node = key < node->key ? node->left : node->right;
+        }
+        return false;
     }
 
-    bool searchRec(Node* node, int key) {
-        if (node == nullptr) return false;
-        if (key == node->key) return true;
-        if (key < node->key) return searchRec(node->left, key);
-        return searchRec(node->right, key);
+    // Пакетный поиск: out[i] = search(keys[i]) для i < count (см. searchBatchInTree)
+    void searchBatch(const int* keys, bool* out, size_t count, int groupSize = 16) const {
+        searchBatchInTree(root, keys, out, count, groupSize);
     }
 
     void remove(int key) {
-        root = removeRec(root, key);
-    }
-
-    Node* removeRec(Node* node, int key) {
-        if (node == nullptr) return node;
-
-        if (key < node->key)
-            node->left = removeRec(node->left, key);
-        else if (key > node->key)
-            node->right = removeRec(node->right, key);
-        else {
-            if (node->left == nullptr) {
-                Node* temp = node->right;
-                delete node;
-                return temp;
-            } else if (node->right == nullptr) {
-                Node* temp = node->left;
-                delete node;
-                return temp;
-            }
+        Node** link = &root;
+        while (*link != nullptr && (*link)->key != key) {
+            link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+        }
+        Node* node = *link;
+        if (node == nullptr) return;
 
-            Node* temp = minValueNode(node->right);
-            node->key = temp->key;
-            node->right = removeRec(node->right, temp->key);
+        if (node->left != nullptr && node->right != nullptr) {
+            // Ключ заменяется минимальным в правом поддереве, удаляется узел-преемник
+            Node** successorLink = &node->right;
+            while ((*successorLink)->left != nullptr) successorLink = &(*successorLink)->left;
+            Node* successor = *successorLink;
+            node->key = successor->key;
+            *successorLink = successor->right;
+            deleteNode(successor);
+        } else {
+            *link = node->left != nullptr ? node->left : node->right;
+            deleteNode(node);
         }
-        return node;
     }
 
     Node* minValueNode(Node* node) {
@@ -93,63 +226,143 @@ public:
         }
     }
 
-    // Очистка памяти
+    // Очистка памяти: с пулом — освобождение блоков целиком, без пула — обход с delete
     void clear() {
-        root = clearRec(root);
+        if (useArena) {
+            arena.clear();
+            root = nullptr;
+        } else {
+            root = clearNodes(root);
+        }
     }
 
-    Node* clearRec(Node* node) {
-        if (node == nullptr) return nullptr;
-        node->left = clearRec(node->left);
-        node->right = clearRec(node->right);
-        delete node;
+    // Обход с явным стеком: у вырожденного дерева глубина равна n
+    Node* clearNodes(Node* node) {
+        vector<Node*> stack;
+        if (node != nullptr) stack.push_back(node);
+        while (!stack.empty()) {
+            Node* current = stack.back();
+            stack.pop_back();
+            if (current->left != nullptr) stack.push_back(current->left);
+            if (current->right != nullptr) stack.push_back(current->right);
+            delete current;
+        }
         return nullptr;
     }
+
+private:
+    bool useArena;
+    NodeArena arena;
 };
 
 class AVLTree {
 public:
     Node* root;
 
-    AVLTree() : root(nullptr) {}
+    // useArena == false — каждый узел через new/delete (для сравнения с пулом)
+    explicit AVLTree(bool useArena = true) : root(nullptr), useArena(useArena) {}
+    ~AVLTree() { clear(); }
 
-    void insert(int key) {
-        root = insertRec(root, key);
-    }
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
 
-    Node* insertRec(Node* node, int key) {
-        if (node == nullptr) return new Node(key);
+    Node* newNode(int key) {
+        return useArena ? arena.allocate(key) : new Node(key);
+    }
 
-        if (key < node->key)
-            node->left = insertRec(node->left, key);
-        else if (key > node->key)
-            node->right = insertRec(node->right, key);
+    void deleteNode(Node* node) {
+        if (useArena)
+            arena.release(node);
         else
-            return node;
+            delete node;
+    }
 
-        node->height = 1 + max(height(node->left), height(node->right));
+    // Построение дерева из произвольного диапазона ключей за O(n) после сортировки: ключи
+    // сортируются и очищаются от повторов, узлы выделяются подряд в порядке ключей, а середина
+    // каждого отрезка становится корнем поддерева, так что дерево идеально сбалансировано.
+    // Прежнее содержимое дерева удаляется. Для n >= parallelBuildThreshold сортировка и связывание
+    // поддеревьев идут в нескольких потоках
+    template <typename Iterator>
+    void buildFrom(Iterator first, Iterator last) {
+        clear();
+        vector<int> keys(first, last);
+        int numThreads = max(1u, thread::hardware_concurrency());
+        parallelSort(keys, numThreads);
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
 
-        int balance = getBalance(node);
+        vector<Node*> nodes(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) nodes[i] = newNode(keys[i]);
 
-        if (balance > 1 && key < node->left->key)
-            return rightRotate(node);
+        // Глубина, до которой левые поддеревья строятся в отдельных потоках
+        int parallelDepth = 0;
+        if (keys.size() >= parallelBuildThreshold) {
+            while ((1 << parallelDepth) < numThreads) ++parallelDepth;
+        }
+        root = linkBalanced(nodes, 0, nodes.size(), parallelDepth);
+    }
 
-        if (balance < -1 && key > node->right->key)
-            return leftRotate(node);
+    // Корень сбалансированного дерева из nodes[begin, end)
+    static Node* linkBalanced(const vector<Node*>& nodes, size_t begin, size_t end, int parallelDepth) {
+        if (begin == end) return nullptr;
+        size_t middle = begin + (end - begin) / 2;
+        Node* node = nodes[middle];
 
-        if (balance > 1 && key > node->left->key) {
-            node->left = leftRotate(node->left);
-            return rightRotate(node);
+        if (parallelDepth > 0) {
+            thread leftBuilder([&] { node->left = linkBalanced(nodes, begin, middle, parallelDepth - 1); });
+            node->right = linkBalanced(nodes, middle + 1, end, parallelDepth - 1);
+            leftBuilder.join();
+        } else {
+            node->left = linkBalanced(nodes, begin, middle, 0);
+            node->right = linkBalanced(nodes, middle + 1, end, 0);
         }
 
-        if (balance < -1 && key < node->right->key) {
-            node->right = rightRotate(node->right);
-            return leftRotate(node);
+        int leftHeight = node->left != nullptr ? node->left->height : 0;
+        int rightHeight = node->right != nullptr ? node->right->height : 0;
+        node->height = 1 + max(leftHeight, rightHeight);
+        return node;
+    }
+
+    // Итеративные операции: спуск запоминает в path адреса указателей на узлы пути
+    // (поле родителя или root), после изменения путь балансируется снизу вверх
+    void insert(int key) {
+        path.clear();
+        Node** link = &root;
+        while (*link != nullptr) {
+            if (key == (*link)->key) return;
+            path.push_back(link);
+            link = key < (*link)->key ? &(*link)->left : &(*link)->right;
         }
+        *link = newNode(key);
+        rebalancePath();
+    }
+
+    // Пересчёт высоты и при необходимости поворот; возвращает новый корень поддерева
+    Node* balance(Node* node) {
+        node->height = 1 + max(height(node->left), height(node->right));
+        int factor = getBalance(node);
 
+        if (factor > 1) {
+            if (getBalance(node->left) < 0) node->left = leftRotate(node->left);
+            return rightRotate(node);
+        }
+        if (factor < -1) {
+            if (getBalance(node->right) > 0) node->right = rightRotate(node->right);
+            return leftRotate(node);
+        }
         return node;
     }
 
+    void rebalancePath() {
+        for (int i = (int)path.size() - 1; i >= 0; --i) {
+            Node** link = path[i];
+            int oldHeight = (*link)->height;
+            Node* oldRoot = *link;
+            *link = balance(*link);
+            // Выше ничего не меняется, если поддерево сохранило корень и высоту
+            if (*link == oldRoot && (*link)->height == oldHeight) break;
+        }
+    }
+
     Node* rightRotate(Node* y) {
         Node* x = y->left;
         Node* T2 = x->right;
@@ -181,43 +394,46 @@ public:
     }
 
     bool search(int key) {
-        return searchRec(root, key);
+        Node* node = root;
+        while (node != nullptr) {
+            if (key == node->key) return true;
+            node = key < node->key ? node->left : node->right;
+        }
+        return false;
     }
 
-    bool searchRec(Node* node, int key) {
-        if (node == nullptr) return false;
-        if (key == node->key) return true;
-        if (key < node->key) return searchRec(node->left, key);
-        return searchRec(node->right, key);
+    // Пакетный поиск: out[i] = search(keys[i]) для i < count (см. searchBatchInTree)
+    void searchBatch(const int* keys, bool* out, size_t count, int groupSize = 16) const {
+        searchBatchInTree(root, keys, out, count, groupSize);
     }
 
     void remove(int key) {
-        root = removeRec(root, key);
-    }
-
-    Node* removeRec(Node* node, int key) {
-        if (node == nullptr) return node;
-
-        if (key < node->key)
-            node->left = removeRec(node->left, key);
-        else if (key > node->key)
-            node->right = removeRec(node->right, key);
-        else {
-            if (node->left == nullptr) {
-                Node* temp = node->right;
-                delete node;
-                return temp;
-            } else if (node->right == nullptr) {
-                Node* temp = node->left;
-                delete node;
-                return temp;
-            }
+        path.clear();
+        Node** link = &root;
+        while (*link != nullptr && (*link)->key != key) {
+            path.push_back(link);
+            link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+        }
+        Node* node = *link;
+        if (node == nullptr) return;
 
-            Node* temp = minValueNode(node->right);
-            node->key = temp->key;
-            node->right = removeRec(node->right, temp->key);
+        if (node->left != nullptr && node->right != nullptr) {
+            // Ключ заменяется минимальным в правом поддереве, удаляется узел-преемник
+            path.push_back(link);
+            Node** successorLink = &node->right;
+            while ((*successorLink)->left != nullptr) {
+                path.push_back(successorLink);
+                successorLink = &(*successorLink)->left;
+            }
+            Node* successor = *successorLink;
+            node->key = successor->key;
+            *successorLink = successor->right;
+            deleteNode(successor);
+        } else {
+            *link = node->left != nullptr ? node->left : node->right;
+            deleteNode(node);
         }
-        return node;
+        rebalancePath();
     }
 
     Node* minValueNode(Node* node) {
@@ -234,18 +450,186 @@ public:
         }
     }
 
-    // Очистка памяти
+    // Очистка памяти: с пулом — освобождение блоков целиком, без пула — обход с delete
     void clear() {
-        root = clearRec(root);
+        if (useArena) {
+            arena.clear();
+            root = nullptr;
+        } else {
+            root = clearNodes(root);
+        }
     }
 
-    Node* clearRec(Node* node) {
-        if (node == nullptr) return nullptr;
-        node->left = clearRec(node->left);
-        node->right = clearRec(node->right);
-        delete node;
+    // Обход с явным стеком: у вырожденного дерева глубина равна n
+    Node* clearNodes(Node* node) {
+        vector<Node*> stack;
+        if (node != nullptr) stack.push_back(node);
+        while (!stack.empty()) {
+            Node* current = stack.back();
+            stack.pop_back();
+            if (current->left != nullptr) stack.push_back(current->left);
+            if (current->right != nullptr) stack.push_back(current->right);
+            delete current;
+        }
         return nullptr;
     }
+
+private:
+    bool useArena;
+    NodeArena arena;
+    vector<Node**> path;  // Путь последней операции
+};
+
+bool hasAvx2() {
+#if defined(__x86_64__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Позиция первого элемента отсортированного массива, не меньшего key (sorted.size(), если такого
+// нет), как у std::lower_bound. Без ветвлений в цикле: отрезок поиска каждый раз сокращается
+// вдвое условной пересылкой
+size_t branchlessLowerBound(const vector<int>& sorted, int key) {
+    const int* base = sorted.data();
+    size_t length = sorted.size();
+    if (length == 0) return 0;
+    while (length > 1) {
+        size_t half = length / 2;
+        base = base[half - 1] < key ? base + half : base;
+        length -= half;
+    }
+    return (base - sorted.data()) + (*base < key);
+}
+
+// Статический индекс в раскладке Эйтцингера: отсортированные ключи лежат в порядке обхода
+// в ширину неявного двоичного дерева (дети узла k — 2k и 2k + 1), так что верхние уровни
+// всех поисков делят одни кэш-линии. Поиск без ветвлений и с упреждающей загрузкой
+// узлов на четыре уровня ниже: потомки k на этом уровне — keys[16k..16k+15], а массив
+// выровнен по 64 байтам с учётом пустого keys[0], так что это ровно одна кэш-линия
+class EytzingerIndex {
+public:
+    // sorted — отсортированные ключи без повторов
+    explicit EytzingerIndex(const vector<int>& sorted)
+        : n(sorted.size()), keys(allocateKeys(sorted.size() + 1), free) {
+        size_t next = 0;
+        fill(sorted, next, 1);
+    }
+
+    // Наименьший ключ, не меньший key (пусто, если такого нет)
+    optional<int> lowerBound(int key) const {
+        size_t k = 1;
+        while (k <= n) {
+            __builtin_prefetch(keys.get() + k * 16);
+            k = 2 * k + (keys[k] < key);
+        }
+        // Последний поворот налево: отбрасываются хвостовые единицы и ещё один бит
+        k >>= __builtin_ffsll(~k);
+        if (k == 0) return nullopt;
+        return keys[k];
+    }
+
+    bool search(int key) const {
+        optional<int> found = lowerBound(key);
+        return found && *found == key;
+    }
+
+private:
+    size_t n;
+    unique_ptr<int[], void (*)(void*)> keys;  // keys[0] не используется
+
+    static int* allocateKeys(size_t count) {
+        size_t bytes = (count * sizeof(int) + 63) / 64 * 64;
+        int* p = static_cast<int*>(aligned_alloc(64, bytes));
+        if (p == nullptr) throw bad_alloc();
+        return p;
+    }
+
+    void fill(const vector<int>& sorted, size_t& next, size_t k) {
+        if (k > n) return;
+        fill(sorted, next, 2 * k);
+        keys[k] = sorted[next++];
+        fill(sorted, next, 2 * k + 1);
+    }
+};
+
+// Статическое S-дерево (B-дерево без указателей): узел — 16 отсортированных ключей в одной
+// кэш-линии, у узла k 17 детей с номерами k * 17 + i + 1. В узле позиция спуска — число
+// ключей меньше искомого, его AVX2 считает двумя сравнениями по 8 ключей и popcount
+class STreeIndex {
+public:
+    static const int blockSize = 16;
+
+    explicit STreeIndex(const vector<int>& sorted)
+        : numBlocks((sorted.size() + blockSize - 1) / blockSize), blocks(numBlocks), realKeys(numBlocks, 0),
+          useAvx2(hasAvx2()) {
+        size_t next = 0;
+        fill(sorted, next, 0);
+    }
+
+    // Наименьший ключ, не меньший key (пусто, если такого нет)
+    optional<int> lowerBound(int key) const {
+        optional<int> result;
+        size_t k = 0;
+        while (k < numBlocks) {
+            int i = useAvx2 ? rankAvx2(blocks[k].keys, key) : rankScalar(blocks[k].keys, key);
+            if (i < realKeys[k]) result = blocks[k].keys[i];
+            k = k * (blockSize + 1) + i + 1;
+        }
+        return result;
+    }
+
+    bool search(int key) const {
+        optional<int> found = lowerBound(key);
+        return found && *found == key;
+    }
+
+private:
+    struct alignas(64) Block {
+        int keys[blockSize];
+    };
+
+    size_t numBlocks;
+    vector<Block> blocks;
+    vector<uint8_t> realKeys;  // Число настоящих ключей в узле, остальное — заполнитель
+    bool useAvx2;
+
+    // Ключи раскладываются в симметричном порядке, поэтому заполнитель INT_MAX идёт после всех
+    // настоящих ключей и в каждом узле занимает суффикс: позиция i < realKeys[k] — настоящий ключ,
+    // и INT_MAX из заполнителя не путается с настоящим INT_MAX
+    void fill(const vector<int>& sorted, size_t& next, size_t k) {
+        if (k >= numBlocks) return;
+        for (int i = 0; i < blockSize; ++i) {
+            fill(sorted, next, k * (blockSize + 1) + i + 1);
+            if (next < sorted.size()) {
+                blocks[k].keys[i] = sorted[next++];
+                ++realKeys[k];
+            } else {
+                blocks[k].keys[i] = INT_MAX;
+            }
+        }
+        fill(sorted, next, k * (blockSize + 1) + blockSize + 1);
+    }
+
+    static int rankScalar(const int* keys, int key) {
+        int count = 0;
+        for (int i = 0; i < blockSize; ++i) count += keys[i] < key;
+        return count;
+    }
+
+#if defined(__x86_64__)
+    __attribute__((target("avx2,popcnt"))) static int rankAvx2(const int* keys, int key) {
+        __m256i x = _mm256_set1_epi32(key);
+        __m256i low = _mm256_cmpgt_epi32(x, _mm256_load_si256((const __m256i*)keys));
+        __m256i high = _mm256_cmpgt_epi32(x, _mm256_load_si256((const __m256i*)(keys + 8)));
+        unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(low)) |
+                        _mm256_movemask_ps(_mm256_castsi256_ps(high)) << 8;
+        return __builtin_popcount(mask);
+    }
+#else
+    static int rankAvx2(const int* keys, int key) { return rankScalar(keys, key); }
+#endif
 };
 
 void generateRandomArray(vector<int>& arr, int size) {
@@ -260,6 +644,9 @@ void generateSortedArray(vector<int>& arr, int size) {
     }
 }
 
+// Результаты поиска в замерах пишутся сюда, чтобы компилятор не выбросил сам поиск
+volatile bool searchSink;
+
 bool linearSearch(const vector<int>& arr, int key) {
     for (int num : arr) {
         if (num == key) {
@@ -269,6 +656,306 @@ bool linearSearch(const vector<int>& arr, int key) {
     return false;
 }
 
+// Первое вхождение key в [begin, end) или end. Векторные варианты сравнивают 16 (AVX-512) или
+// 32 (AVX2, четыре регистра по 8) чисел за итерацию и проверяют совпадения одним переходом
+const int* findScalar(const int* begin, const int* end, int key) {
+    for (const int* p = begin; p != end; ++p) {
+        if (*p == key) return p;
+    }
+    return end;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) const int* findAvx2(const int* begin, const int* end, int key) {
+    __m256i x = _mm256_set1_epi32(key);
+    const int* p = begin;
+    for (; end - p >= 32; p += 32) {
+        __m256i e0 = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i*)p));
+        __m256i e1 = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i*)(p + 8)));
+        __m256i e2 = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i*)(p + 16)));
+        __m256i e3 = _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i*)(p + 24)));
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (!_mm256_testz_si256(any, any)) return findScalar(p, p + 32, key);
+    }
+    return findScalar(p, end, key);
+}
+
+__attribute__((target("avx512f"))) const int* findAvx512(const int* begin, const int* end, int key) {
+    __m512i x = _mm512_set1_epi32(key);
+    const int* p = begin;
+    for (; end - p >= 16; p += 16) {
+        __mmask16 equal = _mm512_cmpeq_epi32_mask(x, _mm512_loadu_si512(p));
+        if (equal) return p + __builtin_ctz(equal);
+    }
+    return findScalar(p, end, key);
+}
+
+__attribute__((target("avx2"))) size_t countAvx2(const int* begin, const int* end, int key) {
+    __m256i x = _mm256_set1_epi32(key);
+    __m256i counts = _mm256_setzero_si256();
+    const int* p = begin;
+    // Совпадение даёт -1 в своей позиции, поэтому вычитание масок накапливает число совпадений
+    for (; end - p >= 8; p += 8) {
+        counts = _mm256_sub_epi32(counts, _mm256_cmpeq_epi32(x, _mm256_loadu_si256((const __m256i*)p)));
+    }
+    alignas(32) unsigned lanes[8];
+    _mm256_store_si256((__m256i*)lanes, counts);
+    size_t total = 0;
+    for (unsigned lane : lanes) total += lane;
+    for (; p != end; ++p) total += *p == key;
+    return total;
+}
+#endif
+
+bool hasAvx512() {
+#if defined(__x86_64__)
+    return __builtin_cpu_supports("avx512f");
+#else
+    return false;
+#endif
+}
+
+// Лучший доступный вариант поиска первого вхождения для этого процессора
+using FindFunction = const int* (*)(const int*, const int*, int);
+
+FindFunction selectFind() {
+#if defined(__x86_64__)
+    __builtin_cpu_init();  // Вызывается при статической инициализации, до main
+    if (hasAvx512()) return findAvx512;
+    if (hasAvx2()) return findAvx2;
+#endif
+    return findScalar;
+}
+
+const FindFunction findFirst = selectFind();
+
+bool linearSearchSimd(const vector<int>& arr, int key) {
+    return findFirst(arr.data(), arr.data() + arr.size(), key) != arr.data() + arr.size();
+}
+
+// Число вхождений key
+size_t linearCount(const vector<int>& arr, int key) {
+    const int* begin = arr.data();
+    const int* end = begin + arr.size();
+#if defined(__x86_64__)
+    if (hasAvx2()) return countAvx2(begin, end, key);
+#endif
+    size_t total = 0;
+    for (const int* p = begin; p != end; ++p) total += *p == key;
+    return total;
+}
+
+// Позиции всех вхождений key по возрастанию
+vector<size_t> linearFindAll(const vector<int>& arr, int key) {
+    vector<size_t> positions;
+    const int* begin = arr.data();
+    const int* end = begin + arr.size();
+    for (const int* p = findFirst(begin, end, key); p != end; p = findFirst(p + 1, end, key)) {
+        positions.push_back(p - begin);
+    }
+    return positions;
+}
+
+// Порог, начиная с которого линейный поиск делится между потоками
+const size_t parallelScanThreshold = 1 << 20;
+
+// Многопоточный линейный поиск: массив делится на равные части, каждая просматривается
+// векторным поиском блоками по scanBlock чисел; нашедший поток поднимает общий флаг,
+// и остальные прекращают работу на границе блока
+bool linearSearchParallel(const vector<int>& arr, int key, int numThreads) {
+    if (numThreads < 2 || arr.size() < parallelScanThreshold) return linearSearchSimd(arr, key);
+
+    const size_t scanBlock = 1 << 16;
+    atomic<bool> found(false);
+    auto worker = [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end && !found.load(memory_order_relaxed); block += scanBlock) {
+            const int* first = arr.data() + block;
+            const int* last = arr.data() + min(end, block + scanBlock);
+            if (findFirst(first, last, key) != last) found.store(true, memory_order_relaxed);
+        }
+    };
+
+    vector<thread> threads;
+    for (int t = 1; t < numThreads; ++t) {
+        threads.emplace_back(worker, arr.size() * t / numThreads, arr.size() * (t + 1) / numThreads);
+    }
+    worker(0, arr.size() / numThreads);
+    for (auto& th : threads) th.join();
+    return found.load();
+}
+
+// Вставка всех элементов arr, поиск keys и очистка для дерева с пулом узлов и без него
+template <typename Tree>
+void benchmarkArena(const string& name, const vector<int>& arr, const vector<int>& keys, int series, ofstream& outfile) {
+    for (bool useArena : {true, false}) {
+        Tree tree(useArena);
+        string label = "Series " + to_string(series) + " (" + name + (useArena ? " Arena" : " New/Delete");
+
+        auto start = high_resolution_clock::now();
+        for (int num : arr) tree.insert(num);
+        auto end = high_resolution_clock::now();
+        auto insertTime = duration_cast<microseconds>(end - start);
+
+        start = high_resolution_clock::now();
+        int found = 0;
+        for (int key : keys) found += tree.search(key);
+        end = high_resolution_clock::now();
+        auto searchTime = duration_cast<microseconds>(end - start);
+
+        start = high_resolution_clock::now();
+        tree.clear();
+        end = high_resolution_clock::now();
+        auto clearTime = duration_cast<microseconds>(end - start);
+
+        string line = label + ") - Insert: " + to_string(insertTime.count()) + " microseconds, Search: " +
+                      to_string(searchTime.count()) + " microseconds (" + to_string(found) + " found), Clear: " +
+                      to_string(clearTime.count()) + " microseconds";
+        cout << line << endl;
+        outfile << line << endl;
+    }
+}
+
+// buildFrom против вставок по одному на больших массивах различных ключей,
+// где построение идёт параллельно (n >= parallelBuildThreshold)
+void benchmarkBulkLoad(ofstream& outfile) {
+    for (int n : {1 << 20, 1 << 22}) {
+        vector<int> keys(n);
+        iota(keys.begin(), keys.end(), 0);
+        shuffle(keys.begin(), keys.end(), mt19937(rand()));
+
+        AVLTree inserted;
+        auto start = high_resolution_clock::now();
+        for (int key : keys) inserted.insert(key);
+        auto end = high_resolution_clock::now();
+        auto insertTime = duration_cast<microseconds>(end - start);
+
+        AVLTree built;
+        start = high_resolution_clock::now();
+        built.buildFrom(keys.begin(), keys.end());
+        end = high_resolution_clock::now();
+        auto buildTime = duration_cast<microseconds>(end - start);
+
+        string line = "Bulk load n = " + to_string(n) + " - AVL Insert: " + to_string(insertTime.count()) +
+                      " microseconds, AVL Build: " + to_string(buildTime.count()) + " microseconds";
+        cout << line << endl;
+        outfile << line << endl;
+    }
+}
+
+// Поиск случайных ключей (попадания и промахи вперемешку) во всех структурах над одними данными.
+// Линейный поиск и BST (на отсортированных данных — список длины n) получают меньше запросов
+void benchmarkStaticSearch(const vector<int>& arr, BinarySearchTree& bst, AVLTree& avl, int series, ofstream& outfile) {
+    vector<int> sorted = arr;
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+    EytzingerIndex eytzinger(sorted);
+    STreeIndex stree(sorted);
+
+    int maxKey = sorted.back() + 1;
+    vector<int> keys(100000);
+    for (int& key : keys) key = rand() % maxKey;
+    const size_t slowCount = 1000;
+
+    auto perOperation = [&](size_t count, auto&& lookup) {
+        auto start = high_resolution_clock::now();
+        for (size_t j = 0; j < count; ++j) searchSink = lookup(keys[j]);
+        auto end = high_resolution_clock::now();
+        return duration_cast<nanoseconds>(end - start).count() / 1000.0 / count;
+    };
+
+    double linear = perOperation(slowCount, [&](int key) { return linearSearch(arr, key); });
+    double bstTime = perOperation(slowCount, [&](int key) { return bst.search(key); });
+    double avlTime = perOperation(keys.size(), [&](int key) { return avl.search(key); });
+    double branchless = perOperation(keys.size(), [&](int key) {
+        size_t position = branchlessLowerBound(sorted, key);
+        return position < sorted.size() && sorted[position] == key;
+    });
+    double eytzingerTime = perOperation(keys.size(), [&](int key) { return eytzinger.search(key); });
+    double streeTime = perOperation(keys.size(), [&](int key) { return stree.search(key); });
+
+    string line = "Series " + to_string(series) + " (Random Keys) - per operation: Linear " + to_string(linear) +
+                  ", BST " + to_string(bstTime) + ", AVL " + to_string(avlTime) + ", Branchless " +
+                  to_string(branchless) + ", Eytzinger " + to_string(eytzingerTime) + ", S-Tree " +
+                  to_string(streeTime) + " microseconds";
+    cout << line << endl;
+    outfile << line << endl;
+}
+
+// Полный просмотр больших массивов (ключа в массиве нет): скалярный поиск, векторный,
+// многопоточный, подсчёт и поиск всех вхождений
+void benchmarkLinearScan(ofstream& outfile) {
+    int numThreads = max(1u, thread::hardware_concurrency());
+    for (int n : {1 << 20, 1 << 22, 1 << 24}) {
+        vector<int> arr(n);
+        generateRandomArray(arr, n);
+        const int missingKey = -1;
+        const int repeats = 20;
+
+        auto perOperation = [&](auto&& scan) {
+            auto start = high_resolution_clock::now();
+            for (int j = 0; j < repeats; ++j) scan();
+            auto end = high_resolution_clock::now();
+            return duration_cast<microseconds>(end - start).count() / (double)repeats;
+        };
+
+        double scalar = perOperation([&] { searchSink = linearSearch(arr, missingKey); });
+        double simd = perOperation([&] { searchSink = linearSearchSimd(arr, missingKey); });
+        double parallel = perOperation([&] { searchSink = linearSearchParallel(arr, missingKey, numThreads); });
+        size_t count = 0, positions = 0;
+        double counting = perOperation([&] { count = linearCount(arr, arr[0]); });
+        double findAll = perOperation([&] { positions = linearFindAll(arr, arr[0]).size(); });
+        if (count != positions) cout << "linearCount и linearFindAll расходятся: " << count << " и " << positions << endl;
+
+        string line = "Linear scan n = " + to_string(n) + " - per operation: Scalar " + to_string(scalar) + ", SIMD " +
+                      to_string(simd) + ", Parallel (" + to_string(numThreads) + " threads) " + to_string(parallel) +
+                      ", Count " + to_string(counting) + ", Find all (" + to_string(positions) + " found) " +
+                      to_string(findAll) + " microseconds";
+        cout << line << endl;
+        outfile << line << endl;
+    }
+}
+
+// Пропускная способность пакетного поиска в зависимости от размера группы на деревьях
+// много больше кэша последнего уровня (2^22 узлов по 32 байта); ключи вставляются в случайном
+// порядке, так что соседние по пути узлы разбросаны по памяти. Группа 1 — обычный search()
+void benchmarkBatchSearch(ofstream& outfile) {
+    const int n = 1 << 22;
+    vector<int> keys(n);
+    iota(keys.begin(), keys.end(), 0);
+    shuffle(keys.begin(), keys.end(), mt19937(rand()));
+
+    BinarySearchTree bst;
+    AVLTree avl;
+    for (int key : keys) {
+        bst.insert(key);
+        avl.insert(key);
+    }
+
+    vector<int> queries(1 << 20);
+    for (int& key : queries) key = rand() % (2 * n);  // Примерно половина промахов
+    unique_ptr<bool[]> found(new bool[queries.size()]);
+
+    auto throughput = [&](auto& tree, int groupSize) {
+        auto start = high_resolution_clock::now();
+        if (groupSize == 1) {
+            for (size_t j = 0; j < queries.size(); ++j) found[j] = tree.search(queries[j]);
+        } else {
+            tree.searchBatch(queries.data(), found.get(), queries.size(), groupSize);
+        }
+        auto end = high_resolution_clock::now();
+        searchSink = found[queries.size() - 1];
+        return queries.size() / (double)duration_cast<microseconds>(end - start).count();
+    };
+
+    for (int groupSize : {1, 2, 4, 8, 16, 32, 64}) {
+        double bstRate = throughput(bst, groupSize);
+        double avlRate = throughput(avl, groupSize);
+        string line = "Batch search n = " + to_string(n) + ", group " + to_string(groupSize) + " - BST " +
+                      to_string(bstRate) + ", AVL " + to_string(avlRate) + " million lookups per second";
+        cout << line << endl;
+        outfile << line << endl;
+    }
+}
 
 int main() {
     srand(time(0));  // Инициализация генератора случайных чисел
@@ -287,15 +974,27 @@ int main() {
             generateSortedArray(arr, n);  // Заполняем отсортированными числами
         }
 
+        int searchKey = rand() % 10000;  // Случайный ключ для поиска
+
         auto start1 = high_resolution_clock::now();
         for (int j = 0; j < 1000; ++j) {
-            linearSearch(arr, searchKey);
+            searchSink = linearSearch(arr, searchKey);
         }
         auto end1 = high_resolution_clock::now();
         auto durationLinearSearch1 = duration_cast<microseconds>(end1 - start1);
         cout << "Series " << i+1 << " (Linear Search) - Time: " << durationLinearSearch1.count() << " microseconds, per operation: " << durationLinearSearch1.count() / 1000.0 << " microseconds" << endl;
         outfile << "Series " << i+1 << " (Linear Search) - Time: " << durationLinearSearch1.count() << " microseconds, per operation: " << durationLinearSearch1.count() / 1000.0 << " microseconds" << endl;
 
+        // Тот же поиск векторным сканированием
+        start1 = high_resolution_clock::now();
+        for (int j = 0; j < 1000; ++j) {
+            searchSink = linearSearchSimd(arr, searchKey);
+        }
+        end1 = high_resolution_clock::now();
+        auto durationSimdSearch = duration_cast<microseconds>(end1 - start1);
+        cout << "Series " << i+1 << " (SIMD Linear Search) - Time: " << durationSimdSearch.count() << " microseconds, per operation: " << durationSimdSearch.count() / 1000.0 << " microseconds" << endl;
+        outfile << "Series " << i+1 << " (SIMD Linear Search) - Time: " << durationSimdSearch.count() << " microseconds, per operation: " << durationSimdSearch.count() / 1000.0 << " microseconds" << endl;
+
 
         // 1. Замер времени для Binary Search Tree
         BinarySearchTree bst;
@@ -305,8 +1004,8 @@ int main() {
         }
         auto end = high_resolution_clock::now();
         auto durationBST = duration_cast<microseconds>(end - start);
-        cout << "Series " << i+1 << " (BST Insert) - Time: " << durationBST.count() << " microseconds" << endl;
-        outfile << "Series " << i+1 << " (BST Insert) - Time: " << durationBST.count() << " microseconds" << endl;
+        cout << "Series " << i+1 << " (BST Insert) - Time: " << durationBST.count() << " microseconds, per operation: " << (double)durationBST.count() / n << " microseconds" << endl;
+        outfile << "Series " << i+1 << " (BST Insert) - Time: " << durationBST.count() << " microseconds, per operation: " << (double)durationBST.count() / n << " microseconds" << endl;
         cout << "2." << endl;
         // 2. Замер времени для AVL Tree
         AVLTree avl;
@@ -316,14 +1015,22 @@ int main() {
         }
         end = high_resolution_clock::now();
         auto durationAVL = duration_cast<microseconds>(end - start);
-        cout << "Series " << i+1 << " (AVL Insert) - Time: " << durationAVL.count() << " microseconds" << endl;
-        outfile << "Series " << i+1 << " (AVL Insert) - Time: " << durationAVL.count() << " microseconds" << endl;
+        cout << "Series " << i+1 << " (AVL Insert) - Time: " << durationAVL.count() << " microseconds, per operation: " << (double)durationAVL.count() / n << " microseconds" << endl;
+        outfile << "Series " << i+1 << " (AVL Insert) - Time: " << durationAVL.count() << " microseconds, per operation: " << (double)durationAVL.count() / n << " microseconds" << endl;
+
+        // Построение AVL-дерева из всего массива сразу, для сравнения с вставками по одному
+        AVLTree built;
+        start = high_resolution_clock::now();
+        built.buildFrom(arr.begin(), arr.end());
+        end = high_resolution_clock::now();
+        auto durationAVLBuild = duration_cast<microseconds>(end - start);
+        cout << "Series " << i+1 << " (AVL Build) - Time: " << durationAVLBuild.count() << " microseconds, per operation: " << (double)durationAVLBuild.count() / n << " microseconds" << endl;
+        outfile << "Series " << i+1 << " (AVL Build) - Time: " << durationAVLBuild.count() << " microseconds, per operation: " << (double)durationAVLBuild.count() / n << " microseconds" << endl;
         
         // 3. Замер времени поиска в Binary Search Tree
-        int searchKey = rand() % 10000;  // Случайный ключ для поиска
         start = high_resolution_clock::now();
         for (int j = 0; j < 1000; ++j) {
-            bst.search(searchKey);
+            searchSink = bst.search(searchKey);
         }
         end = high_resolution_clock::now();
         auto durationBSTSearch = duration_cast<microseconds>(end - start);
@@ -333,13 +1040,16 @@ int main() {
         // 4. Замер времени поиска в AVL Tree
         start = high_resolution_clock::now();
         for (int j = 0; j < 1000; ++j) {
-            avl.search(searchKey);
+            searchSink = avl.search(searchKey);
         }
         end = high_resolution_clock::now();
         auto durationAVLSearch = duration_cast<microseconds>(end - start);
         cout << "Series " << i+1 << " (AVL Search) - Time: " << durationAVLSearch.count() << " microseconds, per operation: " << durationAVLSearch.count() / 1000.0 << " microseconds" << endl;
         outfile << "Series " << i+1 << " (AVL Search) - Time: " << durationAVLSearch.count() << " microseconds, per operation: " << durationAVLSearch.count() / 1000.0 << " microseconds" << endl;
 
+        // Статические индексы против деревьев и линейного поиска на случайных ключах
+        benchmarkStaticSearch(arr, bst, avl, i + 1, outfile);
+
         // 5. Замер времени удаления из Binary Search Tree
         start = high_resolution_clock::now();
         for (int j = 0; j < 1000; ++j) {
@@ -363,7 +1073,23 @@ int main() {
         // Очищаем память
         bst.clear();
         avl.clear();
+
+        // Пул узлов против new/delete: n различных ключей в случайном порядке (в arr их не больше 10000,
+        // а на отсортированных данных BST вырождается в список)
+        if (isRandom) {
+            vector<int> distinct(n);
+            iota(distinct.begin(), distinct.end(), 0);
+            shuffle(distinct.begin(), distinct.end(), mt19937(rand()));
+            vector<int> keys(1000);
+            for (int& key : keys) key = rand() % n;
+            benchmarkArena<BinarySearchTree>("BST", distinct, keys, i + 1, outfile);
+            benchmarkArena<AVLTree>("AVL", distinct, keys, i + 1, outfile);
+        }
     }
+
+    benchmarkBulkLoad(outfile);
+    benchmarkLinearScan(outfile);
+    benchmarkBatchSearch(outfile);
     outfile.close();
 
     return 0;
@@ -5,6 +5,8 @@
 #include <vector>
 #include <random>
 #include <numeric>
+#include <cstdint>
+#include <malloc.h>
 
 class AVLTree {
 public:
@@ -338,6 +340,218 @@ private:
     }
 };
 
+// AVL-дерево с компактными узлами: все узлы лежат в одном векторе, дети задаются 32-битными
+// индексами, а высота (не больше 45 при 2^32 узлах) хранится байтом в отдельном векторе.
+// Узел занимает 12 байт плюс байт высоты вместо 32 байт (и заголовка malloc) у AVLTree::Node;
+// при поиске высоты не читаются. Освобождённые удалением узлы переиспользуются через список
+// свободных, связанный полем left. Операции те же, что у AVLTree
+class CompactAVLTree {
+public:
+    struct Node {
+        int key;
+        uint32_t left;
+        uint32_t right;
+    };
+
+    static const uint32_t nil = UINT32_MAX;
+
+    CompactAVLTree() : root(nil), freeList(nil), size(0) {}
+
+    void insert(int key) {
+        root = insert(root, key);
+    }
+
+    void remove(int key) {
+        root = remove(root, key);
+    }
+
+    bool search(int key) const {
+        uint32_t node = root;
+        while (node != nil) {
+            const Node& current = nodes[node];
+            if (key == current.key) return true;
+            node = key < current.key ? current.left : current.right;
+        }
+        return false;
+    }
+
+    int getMaxDepth() const {
+        return getHeight(root);
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+    // Память под узлы, включая запас ёмкости векторов
+    size_t memoryBytes() const {
+        return nodes.capacity() * sizeof(Node) + heights.capacity() * sizeof(uint8_t);
+    }
+
+private:
+    std::vector<Node> nodes;
+    std::vector<uint8_t> heights;
+    uint32_t root;
+    uint32_t freeList;
+    int size;
+
+    uint32_t allocate(int key) {
+        ++size;
+        if (freeList != nil) {
+            uint32_t node = freeList;
+            freeList = nodes[node].left;
+            nodes[node] = {key, nil, nil};
+            heights[node] = 1;
+            return node;
+        }
+        nodes.push_back({key, nil, nil});
+        heights.push_back(1);
+        return nodes.size() - 1;
+    }
+
+    void release(uint32_t node) {
+        --size;
+        nodes[node].left = freeList;
+        freeList = node;
+    }
+
+    int getHeight(uint32_t node) const {
+        return node == nil ? 0 : heights[node];
+    }
+
+    int getBalance(uint32_t node) const {
+        return node == nil ? 0 : getHeight(nodes[node].left) - getHeight(nodes[node].right);
+    }
+
+    void updateHeight(uint32_t node) {
+        heights[node] = 1 + std::max(getHeight(nodes[node].left), getHeight(nodes[node].right));
+    }
+
+    uint32_t rightRotate(uint32_t y) {
+        uint32_t x = nodes[y].left;
+        nodes[y].left = nodes[x].right;
+        nodes[x].right = y;
+        updateHeight(y);
+        updateHeight(x);
+        return x;
+    }
+
+    uint32_t leftRotate(uint32_t x) {
+        uint32_t y = nodes[x].right;
+        nodes[x].right = nodes[y].left;
+        nodes[y].left = x;
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    uint32_t balance(uint32_t node) {
+        updateHeight(node);
+        int factor = getBalance(node);
+        if (factor > 1) {
+            if (getBalance(nodes[node].left) < 0) nodes[node].left = leftRotate(nodes[node].left);
+            return rightRotate(node);
+        }
+        if (factor < -1) {
+            if (getBalance(nodes[node].right) > 0) nodes[node].right = rightRotate(nodes[node].right);
+            return leftRotate(node);
+        }
+        return node;
+    }
+
+    // Вставка может перераспределить вектор, поэтому ссылки на узлы не держатся через вызовы
+    uint32_t insert(uint32_t node, int key) {
+        if (node == nil) return allocate(key);
+
+        if (key < nodes[node].key) {
+            uint32_t child = insert(nodes[node].left, key);
+            nodes[node].left = child;
+        } else if (key > nodes[node].key) {
+            uint32_t child = insert(nodes[node].right, key);
+            nodes[node].right = child;
+        } else {
+            return node;
+        }
+        return balance(node);
+    }
+
+    uint32_t remove(uint32_t node, int key) {
+        if (node == nil) return node;
+
+        if (key < nodes[node].key) {
+            nodes[node].left = remove(nodes[node].left, key);
+        } else if (key > nodes[node].key) {
+            nodes[node].right = remove(nodes[node].right, key);
+        } else {
+            if (nodes[node].left == nil || nodes[node].right == nil) {
+                uint32_t child = nodes[node].left != nil ? nodes[node].left : nodes[node].right;
+                release(node);
+                return child;
+            }
+
+            uint32_t successor = nodes[node].right;
+            while (nodes[successor].left != nil) successor = nodes[successor].left;
+            nodes[node].key = nodes[successor].key;
+            nodes[node].right = remove(nodes[node].right, nodes[node].key);
+        }
+        return balance(node);
+    }
+};
+
+// Занятая в куче память (malloc), в байтах: по её приросту оценивается память на ключ
+size_t heapBytesInUse() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+// Память на ключ и время поиска AVLTree и CompactAVLTree на 2^10..2^24 различных ключах,
+// вставленных в случайном порядке; ищутся случайные ключи из дерева
+void benchmarkCompactAVL() {
+    std::ofstream outFile("compact_avl.txt");
+    outFile << "N, AVL Bytes Per Key, Compact AVL Bytes Per Key, AVL Avg Search Time, Compact AVL Avg Search Time\n";
+
+    std::mt19937 generator(rand());
+    for (int i = 10; i <= 24; i += 2) {
+        int N = 1 << i;
+        std::cout << "Compact AVL comparison for N = " << N << std::endl;
+
+        std::vector<int> keys(N);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), generator);
+        const int searches = 1000000;
+        std::vector<int> queries(searches);
+        for (int& q : queries) q = keys[generator() % N];
+
+        auto averageSearchTime = [&](auto& tree) {
+            int found = 0;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int q : queries) found += tree.search(q);
+            auto end = std::chrono::high_resolution_clock::now();
+            if (found != searches) std::cout << "Not all keys found: " << found << std::endl;
+            return std::chrono::duration<double>(end - start).count() / searches;
+        };
+
+        double avlBytes, avlSearch;
+        {
+            size_t before = heapBytesInUse();
+            AVLTree avl_tree;
+            for (int key : keys) avl_tree.insert(key);
+            avlBytes = (double)(heapBytesInUse() - before) / N;
+            avlSearch = averageSearchTime(avl_tree);
+        }
+
+        size_t before = heapBytesInUse();
+        CompactAVLTree compact_tree;
+        for (int key : keys) compact_tree.insert(key);
+        double compactBytes = (double)(heapBytesInUse() - before) / N;
+        double compactSearch = averageSearchTime(compact_tree);
+
+        outFile << N << ", " << avlBytes << ", " << compactBytes << ", " << avlSearch << ", " << compactSearch << "\n";
+    }
+
+    std::cout << "Results have been written to compact_avl.txt" << std::endl;
+}
+
 int main() {
     std::ofstream outFile("results.txt");
 
@@ -437,5 +651,7 @@ int main() {
     outFile.close();
     std::cout << "Results have been written to results.txt" << std::endl;
 
+    benchmarkCompactAVL();
+
     return 0;
 }